@@ -2,6 +2,7 @@
 #define DISPLAY_MANAGER_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 // Layout definitions
 typedef enum {
@@ -14,6 +15,18 @@ typedef enum {
     LAYOUT_COUNT
 } display_layout_t;
 
+// Dirty bits: model fields changed since the last refresh
+typedef enum {
+    DISPLAY_DIRTY_TIME       = (1U << 0),
+    DISPLAY_DIRTY_DATE       = (1U << 1),
+    DISPLAY_DIRTY_WEEKDAY    = (1U << 2),
+    DISPLAY_DIRTY_ALARM_TIME = (1U << 3),
+    DISPLAY_DIRTY_ALARM      = (1U << 4),   // Icon visibility / enabled / triggered
+    DISPLAY_DIRTY_LAYOUT     = (1U << 5),   // Whole page must be re-rendered
+    DISPLAY_DIRTY_MARQUEE    = (1U << 6),   // Scroll step due
+    DISPLAY_DIRTY_ALL        = 0x7F
+} display_dirty_t;
+
 // Display state structure
 typedef struct {
     char time_buffer[9];        // HH:MM:SS
@@ -24,14 +37,37 @@ typedef struct {
     bool alarm_enabled;
     bool alarm_triggered;
     bool alarm_icon_visible;
+    uint8_t dirty;              // display_dirty_t bits
 } display_state_t;
 
+// Two-digit fields that can be edited in place
+typedef enum {
+    DISPLAY_FIELD_HOURS,
+    DISPLAY_FIELD_MINUTES,
+    DISPLAY_FIELD_DAY,
+    DISPLAY_FIELD_MONTH,
+    DISPLAY_FIELD_COUNT
+} display_field_t;
 
+// Frame scheduler instrumentation
+typedef struct {
+    uint32_t frames;            // Frames rendered
+    uint32_t dropped;           // Frame periods missed while content was dirty
+    uint32_t over_budget;       // Frames cut short by the I2C byte budget
+    uint32_t last_frame_ms;     // Render + flush time
+    uint32_t max_frame_ms;
+    uint32_t last_frame_bytes;  // Backend bus bytes sent during the render
+    uint32_t max_frame_bytes;
+    uint32_t prepared;              // Frames sent from the pre-rendered next frame
+    uint32_t last_edge_latency_us;  // RTC second edge to the last cell written
+    uint32_t max_edge_latency_us;
+} display_frame_stats_t;
 
 // ===== PUBLIC API =====
 
 // Initialization
 void display_init(void);
+void display_init_warm(void);   // Warm reset: reuse the CGRAM left by the last run
 
 // Model update functions
 void display_set_layout(display_layout_t layout);
@@ -42,12 +78,44 @@ void display_show_alarm_icon(bool show);
 void display_set_alarm_status(bool enabled, bool triggered);
 void display_set_alarm_time(const char* alarm_time_str);
 
-// View refresh function
+// Partial update: the next frame rewrites only the field's two digits
+void display_update_field(display_field_t field, uint8_t value);
+
+// View refresh function: redraws only items bound to dirty fields, now
 void display_refresh(void);
 
+// Frame scheduler: call from the main loop. Renders the merged dirty
+// fields at most DISPLAY_MAX_FPS times a second, each frame capped at
+// the I2C byte budget. Returns true if a frame was rendered.
+bool display_frame_poll(void);
+void display_set_frame_rate(uint8_t max_fps);
+void display_set_frame_budget(uint32_t i2c_bytes);     // 0 = unlimited
+void display_get_frame_stats(display_frame_stats_t* stats);
+void display_reset_frame_stats(void);
+
+// Backend output the main loop must not sleep through (asynchronous
+// backends: the next span can go out now)
+bool display_flush_pending(void);
+
+// Render a layout into the hidden DDRAM page; a later
+// display_set_layout(layout) then flips to it without redrawing
+void display_prerender(display_layout_t layout);
+
+// Marquee banner: the text is written once across a 40-column DDRAM
+// row and scrolled by display-shift commands (one LCD byte per step).
+// The banner owns the screen until stopped; the layout then redraws.
+#define DISPLAY_MARQUEE_MAX 40
+void display_marquee_start(const char* text);
+void display_marquee_stop(void);
+bool display_marquee_active(void);
+
 // Utility functions
 display_layout_t display_get_current_layout(void);
+uint32_t display_get_layout_update_period_ms(display_layout_t layout);
+uint32_t display_get_update_period_ms(void);
 void display_next_layout(void);
 const display_state_t* display_get_state(void);
+uint8_t display_get_dirty_mask(void);       // Pending, not yet drawn
+uint8_t display_get_refreshed_mask(void);   // What the last refresh drew
 
 #endif // DISPLAY_MANAGER_H
@@ -5,6 +5,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include "button.h"
+#include "display_manager.h"
 
 typedef enum {
     STATE_STANDARD = 0,    // Show time/date
@@ -17,11 +18,12 @@ typedef struct {
     system_state_t current_state;
     uint8_t menu_index;
     uint8_t edit_value;
+    display_field_t edit_field;     // RTC field selected by menu_index
     bool display_update_needed;
 } state_machine_t;
 
 void state_machine_init(state_machine_t* sm);
-void state_machine_process_button(state_machine_t* sm, button_event_t btn_event);
+void state_machine_process_button(state_machine_t* sm, const button_event_info_t* btn);
 system_state_t state_machine_get_current_state(const state_machine_t* sm);
 
 #endif
@@ -9,17 +9,57 @@ typedef enum {
     BUTTON_EVENT_NONE = 0,
     BUTTON_EVENT_SHORT_PRESS,   // Released after < 1s (generated after timeout)
     BUTTON_EVENT_LONG_PRESS,    // Released after ≥ 1s
-    BUTTON_EVENT_DOUBLE_CLICK   // Two presses within 300ms
+    BUTTON_EVENT_DOUBLE_CLICK,  // Two presses within 300ms
+    BUTTON_EVENT_REPEAT         // Auto-repeat while held (repeat-enabled buttons only)
 } button_event_t;
 
+/* Button IDs - bit position in GPIOA->IDR and in every button mask */
+typedef enum {
+    BUTTON_HOUR = 0,    // PA0 (Discovery user button)
+    BUTTON_MIN,         // PA1
+    BUTTON_SET,         // PA2
+    BUTTON_ALARM,       // PA3
+    BUTTON_COUNT
+} button_id_t;
+
+/* Queued button event */
+typedef struct {
+    button_event_t event;
+    button_id_t id;
+    uint32_t timestamp_ms;      // systick time the gesture was recognised
+} button_event_info_t;
+
+/* Event queue instrumentation */
+typedef struct {
+    uint32_t queued;            // Events accepted into the queue
+    uint32_t overflows;         // Events dropped because the queue was full
+    uint32_t last_latency_ms;   // Recognition-to-consumption delay of last event
+    uint32_t max_latency_ms;    // Worst delay seen
+} button_queue_stats_t;
+
 
 
 /* Public Functions */
 void button_init(void);
 bool button_is_pressed_raw(void);
 bool button_is_pressed(void);
-button_event_t button_get_event(void);
-void button_update(void);
+button_event_t button_get_event(void);    // HOUR event at the queue head, else NONE (legacy)
 void button_exti_handler(void);
+void button_timer_irq_handler(void);
+void button_capture_irq_handler(void);
+
+/* Multi-button API */
+bool button_is_down(button_id_t id);
+uint8_t button_get_pressed_mask(void);
+
+/* Hold-to-repeat (bit i = button i). A press that produced repeats
+   generates no click or long press on release. */
+void button_set_repeat_mask(uint8_t mask);
+uint8_t button_get_repeat_mask(void);
+
+/* Event queue (single producer: button driver, single consumer: main loop) */
+bool button_poll_event(button_event_info_t* info);
+bool button_event_pending(void);
+void button_get_queue_stats(button_queue_stats_t* stats);
 
 #endif /* BUTTON_H */
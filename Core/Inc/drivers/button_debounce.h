@@ -0,0 +1,32 @@
+/**
+  ******************************************************************************
+  * @file    button_debounce.h
+  * @brief   Parallel vertical-counter debouncer (bit i = button i).
+  * @note    Pure logic on samples passed in: no registers, no time base.
+  *          Builds on the host for the tests/ harness.
+  ******************************************************************************
+  */
+
+#ifndef BUTTON_DEBOUNCE_H
+#define BUTTON_DEBOUNCE_H
+
+#include <stdint.h>
+
+/* Samples a lane must disagree in a row before it toggles */
+#define BUTTON_DEBOUNCE_SAMPLES 4
+
+/* Debouncer state: one bit plane per counter bit, one lane per button */
+typedef struct {
+    uint8_t state;              // Debounced state, 1 = pressed
+    uint8_t cnt0;               // Counter bit 0 plane
+    uint8_t cnt1;               // Counter bit 1 plane
+} button_debounce_t;
+
+/* Start from known levels with all counters cleared */
+void button_debounce_init(button_debounce_t* db, uint8_t levels);
+
+/* Feed one sample of all lanes; returns the lanes whose debounced
+   state toggled */
+uint8_t button_debounce_step(button_debounce_t* db, uint8_t sample);
+
+#endif /* BUTTON_DEBOUNCE_H */
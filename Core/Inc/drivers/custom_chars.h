@@ -10,6 +10,33 @@
 
 #include <stdint.h>
 
+/* Glyph IDs - requested through the glyph cache, not bound to CGRAM slots */
+typedef enum {
+    GLYPH_BELL = 0,
+    GLYPH_ALARM_ON,
+    GLYPH_ALARM_OFF,
+    GLYPH_CHECK,
+    GLYPH_CROSS,
+    GLYPH_CLOCK,
+    GLYPH_CALENDAR,
+    GLYPH_SETTINGS,
+
+    /* Big-digit segments (3x2 cells per digit) */
+    GLYPH_BIG_LT,       /* Upper-left corner */
+    GLYPH_BIG_UB,       /* Upper bar */
+    GLYPH_BIG_RT,       /* Upper-right corner */
+    GLYPH_BIG_LL,       /* Lower-left corner */
+    GLYPH_BIG_LB,       /* Lower bar */
+    GLYPH_BIG_LR,       /* Lower-right corner */
+    GLYPH_BIG_UMB,      /* Upper + middle bars */
+
+    GLYPH_COUNT,
+    GLYPH_NONE = 0xFF
+} glyph_id_t;
+
+/* Bitmap of each glyph, indexed by glyph_id_t */
+extern const uint8_t* const glyph_bitmaps[GLYPH_COUNT];
+
 /* Bell icon */
 extern const uint8_t bell_char[8];
 
@@ -34,4 +61,13 @@ extern const uint8_t calendar_char[8];
 /* Settings/gear icon */
 extern const uint8_t settings_char[8];
 
+/* Big-digit segments */
+extern const uint8_t big_lt_char[8];
+extern const uint8_t big_ub_char[8];
+extern const uint8_t big_rt_char[8];
+extern const uint8_t big_ll_char[8];
+extern const uint8_t big_lb_char[8];
+extern const uint8_t big_lr_char[8];
+extern const uint8_t big_umb_char[8];
+
 #endif /* CUSTOM_CHARS_H */
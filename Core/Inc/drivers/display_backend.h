@@ -0,0 +1,168 @@
+/**
+  ******************************************************************************
+  * @file    display_backend.h
+  * @brief   Display backend, selected at compile time by DISPLAY_TYPE.
+  * @note    The renderer draws into an HD44780-shaped character grid: two
+  *          rows of 40 DDRAM columns, 16 of them visible from the display
+  *          offset, and glyph cells for custom characters. The LCD backend
+  *          maps every call straight onto its driver and inlines away. The
+  *          SSD1306 (pixel) and host terminal backends keep the grid in RAM
+  *          and draw the visible window themselves.
+  ******************************************************************************
+  */
+
+#ifndef DISPLAY_BACKEND_H
+#define DISPLAY_BACKEND_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "board_config.h"
+#include "custom_chars.h"
+
+/* Character grid shared by all backends */
+#define DISPLAY_BACKEND_ROWS            2
+#define DISPLAY_BACKEND_COLS            40      /* DDRAM columns per row */
+#define DISPLAY_BACKEND_VISIBLE_COLS    16
+
+#if DISPLAY_TYPE == DISPLAY_LCD_1602
+
+/* ===== HD44780 behind a PCF8574: direct driver calls ===== */
+
+#include "lcd1602_i2c.h"
+#include "glyph_cache.h"
+
+/* Bring-up (non-blocking; warm = controller kept its configuration) */
+static inline void display_backend_init_start(bool warm) {
+    if (warm) {
+        lcd_init_start_warm();
+    } else {
+        lcd_init_start();
+    }
+}
+
+static inline bool display_backend_init_poll(void) {
+    return lcd_init_poll();
+}
+
+static inline bool display_backend_ready(void) {
+    return lcd_init_get_status() == LCD_INIT_DONE;
+}
+
+static inline void display_backend_power_on(void) {
+    lcd_backlight_on();
+}
+
+/* Custom characters: CGRAM empty (cold) or left by the last run (warm) */
+static inline void display_backend_glyphs_init(bool warm) {
+    if (warm) {
+        glyph_cache_restore();
+    } else {
+        glyph_cache_init();
+    }
+}
+
+/* Blank every cell and move the window back to column 0 */
+static inline void display_backend_clear(void) {
+    lcd_clear();
+    glyph_cache_screen_cleared();
+}
+
+/* Text: set the cursor once, then characters at consecutive cells */
+static inline void display_backend_set_cursor(uint8_t row, uint8_t col) {
+    lcd_set_cursor(row, col);
+}
+
+static inline void display_backend_write_char(uint8_t row, uint8_t col, char c) {
+    glyph_cache_cell_overwritten(row, col);
+    lcd_write_char(c);
+}
+
+/* Glyph at a cell; false if no CGRAM slot could be freed */
+static inline bool display_backend_put_glyph(uint8_t row, uint8_t col, glyph_id_t glyph) {
+    return glyph_cache_put(row, col, glyph);
+}
+
+static inline void display_backend_protect(uint8_t first_col, uint8_t count) {
+    glyph_cache_protect(first_col, count);
+}
+
+static inline void display_backend_redraw_stale(uint8_t first_col, uint8_t count) {
+    glyph_cache_redraw_stale(first_col, count);
+}
+
+/* Evictions so far: a change means glyph cells off-screen may have morphed */
+static inline uint32_t display_backend_glyph_evictions(void) {
+    glyph_cache_stats_t stats;
+    glyph_cache_get_stats(&stats);
+    return stats.evictions;
+}
+
+/* Window over the DDRAM rows (page flips, banner) */
+static inline void display_backend_set_offset(uint8_t offset) {
+    lcd_set_display_offset(offset);
+}
+
+static inline uint8_t display_backend_get_offset(void) {
+    return lcd_get_display_offset();
+}
+
+/* Bus bytes since boot (frame budget and stats) */
+static inline uint32_t display_backend_byte_count(void) {
+    return lcd_get_i2c_byte_count();
+}
+
+/* Writes go out synchronously: nothing to pump */
+static inline bool display_backend_poll(void) {
+    return false;
+}
+
+static inline bool display_backend_pending(void) {
+    return false;
+}
+
+#elif DISPLAY_TYPE == DISPLAY_OLED_SSD1306 || DISPLAY_TYPE == DISPLAY_HOST_TERMINAL
+
+/* ===== Emulated grid (display_backend.c) ===== */
+
+void display_backend_init_start(bool warm);
+bool display_backend_init_poll(void);
+bool display_backend_ready(void);
+void display_backend_power_on(void);
+void display_backend_clear(void);
+void display_backend_set_cursor(uint8_t row, uint8_t col);
+void display_backend_write_char(uint8_t row, uint8_t col, char c);
+bool display_backend_put_glyph(uint8_t row, uint8_t col, glyph_id_t glyph);
+void display_backend_set_offset(uint8_t offset);
+uint8_t display_backend_get_offset(void);
+uint32_t display_backend_byte_count(void);
+
+/* Send the next piece of the visible window; true while work remains */
+bool display_backend_poll(void);
+
+/* Work that can start now (the main loop must not sleep on it) */
+bool display_backend_pending(void);
+
+/* Every glyph is always available: no slots to manage */
+static inline void display_backend_glyphs_init(bool warm) {
+    (void)warm;
+}
+
+static inline void display_backend_protect(uint8_t first_col, uint8_t count) {
+    (void)first_col;
+    (void)count;
+}
+
+static inline void display_backend_redraw_stale(uint8_t first_col, uint8_t count) {
+    (void)first_col;
+    (void)count;
+}
+
+static inline uint32_t display_backend_glyph_evictions(void) {
+    return 0;
+}
+
+#else
+#error "DISPLAY_TYPE: unknown display backend"
+#endif
+
+#endif /* DISPLAY_BACKEND_H */
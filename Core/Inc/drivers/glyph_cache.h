@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file    glyph_cache.h
+  * @brief   CGRAM glyph cache for the HD44780 (8 slots, LRU).
+  ******************************************************************************
+  */
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "custom_chars.h"
+
+/* DDRAM geometry tracked by the cache (two 16-column pages per row) */
+#define GLYPH_CACHE_ROWS        2
+#define GLYPH_CACHE_COLS        32
+#define GLYPH_CACHE_SLOTS       8
+
+/* Upload bytes per glyph: CGRAM address + 8 rows + DDRAM address */
+#define GLYPH_UPLOAD_BYTES      10
+
+/* Cache instrumentation */
+typedef struct {
+    uint32_t hits;              // Glyph already in CGRAM
+    uint32_t misses;            // Glyph had to be uploaded
+    uint32_t evictions;         // Misses that replaced a loaded glyph
+    uint32_t stale_cells;       // On-screen cells invalidated by an eviction
+    uint32_t upload_bytes;      // HD44780 bytes spent on CGRAM uploads
+} glyph_cache_stats_t;
+
+/* Public Functions */
+
+/* Forget CGRAM contents (cold LCD init) */
+void glyph_cache_init(void);
+
+/* Reload the slot map saved in backup registers (warm reset) */
+void glyph_cache_restore(void);
+
+/* Draw a glyph at a cell, uploading it first if needed;
+   false if every slot is protected */
+bool glyph_cache_put(uint8_t row, uint8_t col, glyph_id_t glyph);
+
+/* Never evict slots shown in these columns (count 0 = no protection) */
+void glyph_cache_protect(uint8_t first_col, uint8_t count);
+
+/* Screen was cleared or a cell overwritten by text */
+void glyph_cache_screen_cleared(void);
+void glyph_cache_cell_overwritten(uint8_t row, uint8_t col);
+
+/* Redraw cells in a column window whose slot was evicted;
+   returns number redrawn */
+uint8_t glyph_cache_redraw_stale(uint8_t first_col, uint8_t count);
+
+/* Slot of a glyph, or -1 if not loaded */
+int8_t glyph_cache_find(glyph_id_t glyph);
+
+void glyph_cache_get_stats(glyph_cache_stats_t* stats);
+void glyph_cache_reset_stats(void);
+
+#endif /* GLYPH_CACHE_H */
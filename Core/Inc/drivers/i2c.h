@@ -18,4 +18,14 @@ void i2c_init(void);
 i2c_status_t i2c_write_byte(uint8_t dev_addr, uint8_t data);
 i2c_status_t i2c_write_bytes(uint8_t dev_addr, const uint8_t* data, uint8_t len);
 
+/* Bulk write: the whole buffer in one transaction, sent by DMA. Returns at
+   once; the buffer must stay valid until i2c_dma_busy() is false. */
+i2c_status_t i2c_write_dma(uint8_t dev_addr, const uint8_t* data, uint16_t len);
+bool i2c_dma_busy(void);
+i2c_status_t i2c_get_last_error(void);
+
+/* Interrupt handlers (DMA1 Stream6, I2C1 event) */
+void i2c_dma_irq_handler(void);
+void i2c_ev_irq_handler(void);
+
 #endif /* I2C_H */
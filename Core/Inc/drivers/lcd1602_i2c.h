@@ -2,6 +2,7 @@
 #define LCD1602_I2C_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /* LCD I2C Address (7-bit) */
 #define LCD_I2C_ADDR    0x27
@@ -16,15 +17,35 @@
 #define LCD_D6          (1 << 6)
 #define LCD_D7          (1 << 7)
 
+/* DDRAM columns per row in 2-line mode (16 visible) */
+#define LCD_DDRAM_COLS  40
+
+/* HD44780 needs > 40 ms after Vcc rises before the first command */
+#define LCD_POWER_UP_MS 50
+
+/* Non-blocking init state */
+typedef enum {
+    LCD_INIT_IDLE = 0,
+    LCD_INIT_BUSY,
+    LCD_INIT_DONE
+} lcd_init_status_t;
+
 /* Public Functions */
 void lcd_init(void);
+void lcd_init_start(void);
+void lcd_init_start_warm(void);
+bool lcd_init_poll(void);
+lcd_init_status_t lcd_init_get_status(void);
 void lcd_clear(void);
 void lcd_home(void);
 void lcd_set_cursor(uint8_t row, uint8_t col);
+void lcd_set_display_offset(uint8_t offset);
+uint8_t lcd_get_display_offset(void);
 void lcd_write_char(char c);
 void lcd_write_string(const char* str);
 void lcd_backlight_on(void);
 void lcd_backlight_off(void);
+uint32_t lcd_get_i2c_byte_count(void);
 
 
 
@@ -90,13 +90,15 @@ void led_all_toggle(void);
 void led_set_pattern(uint8_t pattern);
 
 /**
- * @brief Simple chase pattern (for testing)
+ * @brief Start the chase pattern on the DMA sequencer (non-blocking)
  * @param delay_ms Time between steps (ms)
+ * @note Requires led_pattern_init(); stop with led_pattern_stop()
  */
 void led_chase(uint32_t delay_ms);
 
 /**
- * @brief Knight Rider pattern
+ * @brief Start the Knight Rider pattern on the DMA sequencer (non-blocking)
+ * @note Requires led_pattern_init(); stop with led_pattern_stop()
  */
 void led_knight_rider(void);
 
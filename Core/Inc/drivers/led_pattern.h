@@ -0,0 +1,76 @@
+#ifndef LED_PATTERN_H
+#define LED_PATTERN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "board_config.h"
+
+// DMA LED sequencer: a timer-paced DMA stream copies a const table of
+// BSRR words into LED_GPIO_PORT->BSRR, one word per step. Animations run
+// alongside everything else with no CPU involvement.
+//
+// Every word should set AND reset so a step fully defines all four LEDs.
+// LEDs attached to led_pwm ignore BSRR writes.
+
+// Build a BSRR word that lights exactly the LEDs in on_mask
+#define LED_BSRR(on_mask) \
+    ((uint32_t)(on_mask) | ((uint32_t)(LED_ALL_PINS & ~(on_mask)) << 16))
+
+typedef enum {
+    LED_PATTERN_ONESHOT = 0,    // Play once, last step stays latched
+    LED_PATTERN_CIRCULAR        // Loop until stopped
+} led_pattern_mode_t;
+
+typedef struct {
+    const uint32_t* steps;      // BSRR words
+    uint16_t length;            // Number of steps
+} led_pattern_t;
+
+//================================
+// Built-in patterns
+//================================
+extern const led_pattern_t led_pattern_chase;         // G -> O -> R -> B
+extern const led_pattern_t led_pattern_knight_rider;  // G -> B -> G bounce
+extern const led_pattern_t led_pattern_alarm;         // Alternating pairs, all-on flash
+extern const led_pattern_t led_pattern_blink_all;     // All on / all off
+
+//================================
+// Sequencer control
+//================================
+
+/**
+ * @brief Enable TIM8 and DMA2 clocks and configure the stream
+ */
+void led_pattern_init(void);
+
+/**
+ * @brief Start playing a pattern (replaces any running one)
+ * @param pattern Pattern table (must stay valid while playing)
+ * @param step_ms Time per step (1 - 6553 ms)
+ * @param mode One-shot or circular
+ * @return false on invalid arguments
+ * @note The first step is output immediately
+ */
+bool led_pattern_start(const led_pattern_t* pattern, uint32_t step_ms, led_pattern_mode_t mode);
+
+/**
+ * @brief Stop the sequencer, LEDs keep their current state
+ */
+void led_pattern_stop(void);
+
+/**
+ * @brief Check whether a pattern is playing
+ */
+bool led_pattern_is_running(void);
+
+/**
+ * @brief Check whether a given pattern is the one playing
+ */
+bool led_pattern_is_playing(const led_pattern_t* pattern);
+
+/**
+ * @brief DMA transfer-complete handler (call from DMA2_Stream1_IRQHandler)
+ */
+void led_pattern_dma_irq_handler(void);
+
+#endif /* LED_PATTERN_H */
@@ -0,0 +1,81 @@
+#ifndef LED_PWM_H
+#define LED_PWM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "board_config.h"
+
+// Hardware LED engine: TIM4 drives PD12-PD15 directly, so blinking and
+// dimming need no CPU once configured and keep running in Sleep mode.
+//
+// TIM4 has a single auto-reload register: all four channels share one
+// period. Each LED has its own duty. An LED attached to PWM ignores
+// led_on()/led_off() until led_pwm_release() hands it back to GPIO.
+
+//================================
+// Timer control
+//================================
+
+/**
+ * @brief Start TIM4 at LED_PWM_TICK_US resolution with LED_PWM_DIM_PERIOD_US period
+ * @note All channels start detached (pins stay plain GPIO outputs)
+ */
+void led_pwm_init(void);
+
+/**
+ * @brief Set the period shared by all PWM LEDs
+ * @param period_us Period in microseconds (rounded to LED_PWM_TICK_US)
+ * @return false if out of range (2 ticks .. 65536 ticks)
+ * @note Duties are kept as a fraction of the period
+ */
+bool led_pwm_set_period_us(uint32_t period_us);
+
+/**
+ * @brief Get the current shared period
+ * @return Period in microseconds
+ */
+uint32_t led_pwm_get_period_us(void);
+
+//================================
+// Per-LED control
+//================================
+
+/**
+ * @brief Attach an LED to its TIM4 channel with the given duty
+ * @param led LED identifier (LED_ALL for all four)
+ * @param permille ON fraction, 0-1000
+ */
+void led_pwm_set_duty(led_id_t led, uint16_t permille);
+
+/**
+ * @brief Dim an LED at the flicker-free rate
+ * @param led LED identifier (LED_ALL for all four)
+ * @param percent Brightness, 0-100
+ * @note Switches the shared period to LED_PWM_DIM_PERIOD_US
+ */
+void led_pwm_set_brightness(led_id_t led, uint8_t percent);
+
+/**
+ * @brief Blink an LED in hardware
+ * @param led LED identifier (LED_ALL for all four)
+ * @param on_time_ms Time LED stays ON (milliseconds)
+ * @param off_time_ms Time LED stays OFF (milliseconds)
+ * @return false if on + off does not fit the timer
+ * @note Sets the shared period to on + off: other PWM LEDs follow it
+ */
+bool led_pwm_blink(led_id_t led, uint32_t on_time_ms, uint32_t off_time_ms);
+
+/**
+ * @brief Detach an LED from TIM4 and return it to GPIO control (OFF)
+ * @param led LED identifier (LED_ALL for all four)
+ */
+void led_pwm_release(led_id_t led);
+
+/**
+ * @brief Check whether an LED is driven by TIM4
+ * @param led LED identifier
+ * @return true if attached to PWM
+ */
+bool led_pwm_is_attached(led_id_t led);
+
+#endif /* LED_PWM_H */
@@ -56,8 +56,27 @@ typedef struct {
     uint8_t mask;       /* Alarm mask bits (see RTC_ALARM_MASK_xxx) */
     uint8_t weekday;    /* 1-7: Match weekday (0 = ignore) */
     bool enabled;       /* Alarm enabled flag */
+    uint16_t millisecond;   /* 0-999: Sub-second match point */
+    uint8_t subsecond_mask; /* MASKSS: low SS bits compared (0 = whole seconds) */
 } rtc_alarm_t;
 
+/**
+  * @brief  Hardware alarm selection
+  */
+typedef enum {
+    RTC_ALARM_A = 0,
+    RTC_ALARM_B = 1
+} rtc_alarm_id_t;
+
+/**
+  * @brief  Delay between programmed match and alarm ISR entry
+  */
+typedef struct {
+    uint32_t last_us;   /* Last observed delay */
+    uint32_t max_us;    /* Worst observed delay */
+    uint32_t count;     /* Alarms measured */
+} rtc_alarm_jitter_t;
+
 /*====================================================================
 	Periodic Interrupt Types
 =================================================================*/
@@ -69,7 +88,11 @@ typedef enum {
     RTC_PERIODIC_EVERY_HOUR = 3,     /* Interrupt every hour */
     RTC_PERIODIC_EVERY_10_SECONDS = 4, /* Interrupt every 10 seconds */
     RTC_PERIODIC_EVERY_30_SECONDS = 5, /* Interrupt every 30 seconds */
-    RTC_PERIODIC_EVERY_CUSTOM = 6    /* Custom interval */
+    RTC_PERIODIC_EVERY_CUSTOM = 6,   /* Custom interval */
+    RTC_PERIODIC_EVERY_100MS = 7,    /* Interrupt every 100 ms */
+    RTC_PERIODIC_EVERY_250MS = 8,    /* Interrupt every 250 ms */
+    RTC_PERIODIC_EVERY_500MS = 9,    /* Interrupt every 500 ms */
+    RTC_PERIODIC_EVERY_CUSTOM_MS = 10 /* Custom interval in milliseconds */
 } rtc_periodic_rate_t;
 
 /* Wakeup Timer Clock Selection */
@@ -86,10 +109,23 @@ typedef enum {
 typedef struct {
     rtc_periodic_rate_t rate;
     uint16_t custom_interval;      /* For custom intervals in seconds */
-    rtc_wakeup_clock_t clock_source;
+    uint32_t custom_interval_ms;   /* For RTC_PERIODIC_EVERY_CUSTOM_MS */
+    rtc_wakeup_clock_t clock_source; /* Selected automatically from the interval */
     bool enabled;
 } rtc_wakeup_config_t;
 
+/* Wakeup tick accounting (rate switches and overruns) */
+typedef struct {
+    uint32_t ticks;             /* Wakeup interrupts serviced */
+    uint32_t missed_ticks;      /* Intervals that elapsed without their own interrupt */
+    uint32_t merged_ticks;      /* Old-rate ticks pending at a switch, delivered with it */
+    uint32_t rate_changes;      /* Successful interval switches */
+    uint32_t switch_failures;   /* Switches aborted on write-access timeout */
+} rtc_wakeup_stats_t;
+
+/* Wakeup subscriber callback (runs in RTC wakeup interrupt context) */
+typedef void (*rtc_wakeup_handler_t)(void);
+
 
 
 /*===================================================================
@@ -141,6 +177,12 @@ bool rtc_set_date(const rtc_date_t* date);
   */
 void rtc_get_date(rtc_date_t* date);
 
+/**
+  * @brief  Time elapsed since the last second increment
+  * @retval Microseconds (SSR based, resolution 1/(PREDIV_S+1) s)
+  */
+uint32_t rtc_get_subsecond_us(void);
+
 /*===================================================================
   Alarm Functions
   ===================================================================*/
@@ -154,6 +196,36 @@ void rtc_get_date(rtc_date_t* date);
 	  */
 	bool rtc_alarm_init(void);
 
+	/**
+	  * @brief  Set alarm configuration (A or B)
+	  * @param  id: Alarm to program
+	  * @param  alarm: Pointer to alarm configuration
+	  * @retval true: Success, false: Failure
+	  * @note   millisecond + subsecond_mask program ALRMxSSR. Resolution is
+	  *         one ck_apre period (1/(PREDIV_S+1) s, 3.9 ms with PREDIV_S = 255).
+	  *         A small MASKSS with MSK1..4 set gives a periodic sub-second alarm.
+	  */
+	bool rtc_set_alarm(rtc_alarm_id_t id, const rtc_alarm_t* alarm);
+
+	/**
+	  * @brief  Enable / disable an alarm
+	  */
+	void rtc_alarm_enable(rtc_alarm_id_t id);
+	void rtc_alarm_disable(rtc_alarm_id_t id);
+
+	/**
+	  * @brief  Check / clear an alarm trigger flag
+	  */
+	bool rtc_is_alarm_triggered(rtc_alarm_id_t id);
+	void rtc_clear_alarm(rtc_alarm_id_t id);
+
+	/**
+	  * @brief  Get fire-time jitter measured in the alarm ISR
+	  * @param  id: Alarm to query
+	  * @param  jitter: Pointer to jitter structure (output)
+	  */
+	void rtc_alarm_get_jitter(rtc_alarm_id_t id, rtc_alarm_jitter_t* jitter);
+
 	/**
 	  * @brief  Set alarm A configuration
 	  * @param  alarm: Pointer to alarm configuration
@@ -192,6 +264,11 @@ void rtc_get_date(rtc_date_t* date);
 	  */
 	void rtc_alarm_callback(void);
 
+	/**
+	  * @brief  Application alarm B callback (weak, override in application)
+	  */
+	void rtc_alarm_b_callback(void);
+
 #endif /* RTC_ALARM_ENABLE */
 
 /*=============================================================
@@ -202,12 +279,57 @@ void rtc_get_date(rtc_date_t* date);
     bool rtc_periodic_init_custom(const rtc_wakeup_config_t* config);
     void rtc_periodic_enable(void);
     void rtc_periodic_disable(void);
-    void rtc_periodic_set_rate(rtc_periodic_rate_t rate);
-    void rtc_periodic_set_custom_interval(uint16_t seconds);
+    bool rtc_periodic_set_rate(rtc_periodic_rate_t rate);
+    bool rtc_periodic_set_custom_interval(uint16_t seconds);
+    bool rtc_periodic_set_interval_ms(uint32_t interval_ms);
+    uint32_t rtc_periodic_get_interval_ms(void);
+    void rtc_wakeup_get_stats(rtc_wakeup_stats_t* stats);
+    void rtc_wakeup_reset_stats(void);
     bool rtc_is_periodic_triggered(void);
     void rtc_clear_periodic_flag(void);
     void rtc_wakeup_irq_handler(void);
     void rtc_periodic_callback(void);  /* User callback for LCD update */
+
+    /**
+      * @brief  Register a handler on the shared wakeup timer
+      * @param  handler: Callback, called from the wakeup interrupt
+      * @param  period_ms: Call period in milliseconds
+      * @param  phase_ms: Delay of the first call (0 = one full period), < period_ms
+      * @retval true: Success, false: Table full, invalid arguments or no
+      *         exact base period
+      * @note   Re-subscribing an existing handler updates its period and phase.
+      *         The hardware rate becomes the GCD of all periods and phases.
+      * @note   Every base tick must be a whole number of wakeup clock ticks,
+      *         or handlers built from several ticks drift off the calendar
+      *         second. Below 1 s that means multiples of 125 ms (32.768 kHz
+      *         RTCCLK). A GCD that is not exact, or that the 1 Hz clock
+      *         cannot count, runs at its GCD with 125 ms instead (32.5 s
+      *         ticks every 125 ms). A set with no exact base at all (e.g. a
+      *         100 ms period) is refused and the table is left unchanged.
+      */
+    bool rtc_wakeup_subscribe(rtc_wakeup_handler_t handler, uint32_t period_ms, uint32_t phase_ms);
+
+    /**
+      * @brief  Remove a handler from the wakeup dispatcher
+      * @retval true: Removed, false: Not subscribed
+      * @note   The wakeup timer is stopped when the last subscriber leaves
+      */
+    bool rtc_wakeup_unsubscribe(rtc_wakeup_handler_t handler);
+
+    /**
+      * @brief  Run a subscriber now, from the wakeup interrupt
+      * @retval true: Pended, false: Not subscribed
+      * @note   Pends the wakeup IRQ; the handler runs in its usual context,
+      *         so data it owns keeps a single writer. Its schedule and the
+      *         tick statistics are not affected.
+      */
+    bool rtc_wakeup_trigger(rtc_wakeup_handler_t handler);
+
+    /**
+      * @brief  Get the hardware wakeup period chosen by the dispatcher
+      * @retval Period in milliseconds (0 when no subscribers)
+      */
+    uint32_t rtc_wakeup_get_base_ms(void);
 #endif
 
 
@@ -0,0 +1,59 @@
+/**
+  ******************************************************************************
+  * @file    ssd1306.h
+  * @brief   SSD1306 128x64 OLED driver (I2C, DMA page flushes).
+  ******************************************************************************
+  */
+
+#ifndef SSD1306_H
+#define SSD1306_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Panel geometry: 8 pages of 8 pixel rows, one byte = 8 vertical pixels */
+#define SSD1306_WIDTH           128
+#define SSD1306_HEIGHT          64
+#define SSD1306_PAGES           (SSD1306_HEIGHT / 8)
+
+/* Small font: 5x7 in a 6-pixel pitch, one page tall */
+#define SSD1306_FONT_W          5
+#define SSD1306_FONT_PITCH      6
+
+/* Big digits: small font scaled 3x, 15x21 in three pages */
+#define SSD1306_BIG_W           15
+#define SSD1306_BIG_PITCH       18
+#define SSD1306_BIG_PAGES       3
+
+/* Flush instrumentation */
+typedef struct {
+    uint32_t flushes;           // Dirty spans sent
+    uint32_t i2c_bytes;         // Bytes on the bus (control + commands + pixels)
+    uint32_t pixel_bytes;       // Framebuffer bytes sent
+    uint32_t i2c_errors;        // Transfers that failed to start
+} ssd1306_stats_t;
+
+/* Public Functions */
+
+/* Send the init sequence (blocking) and clear the panel */
+bool ssd1306_init(void);
+
+/* Drawing into the framebuffer; only bytes that change mark their page dirty */
+void ssd1306_clear(void);
+void ssd1306_fill(uint8_t x, uint8_t page, uint8_t width, uint8_t pages, uint8_t pattern);
+void ssd1306_draw_char(uint8_t x, uint8_t page, char c);
+void ssd1306_draw_text(uint8_t x, uint8_t page, const char* str);
+void ssd1306_draw_big_char(uint8_t x, uint8_t page, char c);  // '0'-'9', ':' and ' '
+
+/* Send the next dirty span by DMA; call from the main loop.
+   Returns true while spans remain or a transfer is in flight. */
+bool ssd1306_flush_poll(void);
+bool ssd1306_is_dirty(void);
+
+/* Framebuffer (page-major, 128 bytes per page) for inspection */
+const uint8_t* ssd1306_get_framebuffer(void);
+
+void ssd1306_get_stats(ssd1306_stats_t* stats);
+void ssd1306_reset_stats(void);
+
+#endif /* SSD1306_H */
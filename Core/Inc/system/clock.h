@@ -0,0 +1,24 @@
+#ifndef _CLOCK_H_
+#define _CLOCK_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Kernel clock of the APB1 timers (TIM2-TIM7, TIM12-TIM14).
+  * @note   Read from RCC->CFGR on every call: twice PCLK1 whenever APB1
+  *         is divided from HCLK, so timer setups follow the bus prescaler.
+  * @retval Clock in Hz.
+  */
+uint32_t clock_apb1_timer_hz(void);
+
+/**
+  * @brief  Kernel clock of the APB2 timers (TIM1, TIM8-TIM11).
+  * @note   Same rule as APB1, from the PPRE2 divider.
+  * @retval Clock in Hz.
+  */
+uint32_t clock_apb2_timer_hz(void);
+
+#endif /* _CLOCK_H_ */
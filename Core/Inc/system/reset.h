@@ -0,0 +1,59 @@
+#ifndef _RESET_H_
+#define _RESET_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Reset cause, decoded from RCC->CSR (highest priority first).
+  */
+typedef enum {
+    RESET_CAUSE_UNKNOWN = 0,
+    RESET_CAUSE_LOW_POWER,      /*!< Illegal Stop/Standby entry */
+    RESET_CAUSE_WWDG,           /*!< Window watchdog */
+    RESET_CAUSE_IWDG,           /*!< Independent watchdog */
+    RESET_CAUSE_SOFTWARE,       /*!< NVIC_SystemReset() */
+    RESET_CAUSE_POWER_ON,       /*!< POR/PDR - everything lost power */
+    RESET_CAUSE_BROWNOUT,       /*!< BOR - supply dipped */
+    RESET_CAUSE_PIN             /*!< NRST pin only (reset button, debugger) */
+} reset_cause_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Latch and clear the reset flags, read the warm-boot marker.
+  * @note   Call once, first thing in main(). Reading needs no backup
+  *         domain access.
+  * @retval None
+  */
+void reset_init(void);
+
+/**
+  * @brief  Get the cause of the last reset.
+  * @retval Reset cause latched by reset_init().
+  */
+reset_cause_t reset_get_cause(void);
+
+/**
+  * @brief  Check whether the LCD survived the reset configured.
+  * @note   True only if the supply never dropped (no POR/BOR) AND the
+  *         previous run finished LCD bring-up (backup-register marker).
+  *         With VBAT the marker outlives a power cycle, so both are needed.
+  * @retval true: fast boot is safe, false: full LCD init required.
+  */
+bool reset_is_warm(void);
+
+/**
+  * @brief  Set or clear the "LCD configured" backup-register marker.
+  * @note   Needs backup domain write access (enabled by rtc_init()).
+  *         Clear it before LCD bring-up, set it once glyphs are loaded, so
+  *         a reset during bring-up always falls back to the full init.
+  * @param  valid: true to set, false to clear.
+  * @retval None
+  */
+void reset_set_display_marker(bool valid);
+
+#endif /* _RESET_H_ */
@@ -1,6 +1,9 @@
 #include "display_manager.h"
-#include "lcd1602_i2c.h"
+#include "display_backend.h"
 #include "custom_chars.h"
+#include "board_config.h"
+#include "systick.h"
+#include "rtc.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -16,176 +19,1011 @@ static display_state_t display_state = {
     .time_buffer = "00:00:00",
     .date_buffer = "01/01/2000",
     .weekday_buffer = "Monday",
-    .alarm_time_buffer = "00:00"
+    .alarm_time_buffer = "00:00",
+    .dirty = DISPLAY_DIRTY_ALL
+};
+
+// Weekday length, kept at update time so centring needs no strlen
+static uint8_t weekday_len = 6;
+
+// Seqlock: writers (the RTC wakeup ISR and main-loop setters) make the
+// sequence odd while they change the model and even again after. The
+// renderer copies the model into the view and retries if the sequence
+// moved, so it never draws a half-written string. No IRQ masking and
+// writers never wait. Each field has one writer: time and date come
+// only from the wakeup ISR (main pends it with rtc_wakeup_trigger), the
+// rest only from the main loop. The one exception is an edited field's
+// two digits (display_update_field): they are written after the RTC
+// took the value, so an ISR overlapping them stores the same digits.
+static volatile uint32_t model_seq = 0;
+
+// DWT cycle count at the RTC second edge that produced the time string
+static uint32_t time_edge_cycles = 0;
+
+// Consistent copy of the model the renderer draws from
+static display_state_t view;
+static uint8_t view_weekday_len = 6;
+static uint32_t view_edge_cycles = 0;
+
+
+// Dirty bits handled by the last refresh (instrumentation)
+static uint8_t refreshed_mask = 0;
+
+// Frame scheduler: at most one render per frame period, each capped
+// at a backend bus byte budget; producers only mark fields dirty
+static uint32_t frame_period_ms = 1000 / DISPLAY_MAX_FPS;
+static uint32_t frame_budget = DISPLAY_FRAME_I2C_BUDGET;
+static uint32_t next_frame_ms = 0;
+static display_frame_stats_t frame_stats;
+
+// Where each editable field lives inside its model buffer
+typedef struct {
+    char* buffer;
+    uint8_t offset;
+} field_location_t;
+
+static const field_location_t field_location[DISPLAY_FIELD_COUNT] = {
+    [DISPLAY_FIELD_HOURS]   = { display_state.time_buffer, 0 },
+    [DISPLAY_FIELD_MINUTES] = { display_state.time_buffer, 3 },
+    [DISPLAY_FIELD_DAY]     = { display_state.date_buffer, 0 },
+    [DISPLAY_FIELD_MONTH]   = { display_state.date_buffer, 3 },
 };
 
 // ============================================
-// PRIVATE HELPER FUNCTIONS
+// LAYOUT DESCRIPTORS
 // ============================================
 
-// Draw combined date+weekday for FULL layout
-static void draw_full_layout_line2(void) {
-    char buffer[17];
-    char short_weekday[4];
+// What a layout item shows
+typedef enum {
+    ITEM_TIME,              // HH:MM:SS
+    ITEM_HHMM,              // HH:MM
+    ITEM_BIG_TIME,          // HH:MM two rows tall (col/width ignored)
+    ITEM_DATE,              // DD/MM/YYYY
+    ITEM_WEEKDAY,           // Weekday name, cut to width
+    ITEM_WEEKDAY_SCROLL,    // Weekday name, scrolled through width if longer
+    ITEM_ALARM_TIME,        // HH:MM
+    ITEM_ALARM_ICON,        // On/off glyph while the icon is visible
+    ITEM_ALARM_STATE,       // Ringing/armed/off glyph while the icon is visible
+    ITEM_LABEL              // Constant text
+} layout_item_kind_t;
 
-    // Get first 3 chars of weekday
-    strncpy(short_weekday, display_state.weekday_buffer, 3);
-    short_weekday[3] = '\0';
+typedef enum {
+    ALIGN_LEFT,         // Text starts at col
+    ALIGN_CENTER        // Text centred in [col, col + width)
+} layout_align_t;
 
-    snprintf(buffer, sizeof(buffer), "%s %s",
-             display_state.date_buffer, short_weekday);
-    lcd_set_cursor(1, 0);
-    lcd_write_string(buffer);
-}
+typedef struct {
+    uint8_t row;
+    uint8_t col;
+    uint8_t kind;       // layout_item_kind_t
+    uint8_t align;      // layout_align_t
+    uint8_t width;      // Max cells written
+    const char* label;  // ITEM_LABEL only
+} layout_item_t;
+
+// Model field each item kind shows (labels only change with the layout)
+static const uint8_t item_dirty_bit[] = {
+    [ITEM_TIME]           = DISPLAY_DIRTY_TIME,
+    [ITEM_HHMM]           = DISPLAY_DIRTY_TIME,
+    [ITEM_BIG_TIME]       = DISPLAY_DIRTY_TIME,
+    [ITEM_DATE]           = DISPLAY_DIRTY_DATE,
+    [ITEM_WEEKDAY]        = DISPLAY_DIRTY_WEEKDAY,
+    [ITEM_WEEKDAY_SCROLL] = DISPLAY_DIRTY_WEEKDAY | DISPLAY_DIRTY_MARQUEE,
+    [ITEM_ALARM_TIME]     = DISPLAY_DIRTY_ALARM_TIME,
+    [ITEM_ALARM_ICON]     = DISPLAY_DIRTY_ALARM,
+    [ITEM_ALARM_STATE]    = DISPLAY_DIRTY_ALARM,
+    [ITEM_LABEL]          = 0,
+};
+
+typedef struct {
+    const layout_item_t* items;
+    uint8_t count;
+    uint32_t update_period_ms;  // Coarse layouts let the RTC wake the MCU
+                                // (and the I2C bus) once a minute
+} layout_desc_t;
+
+// Column that centres a fixed-width field on the 16-column row
+#define CENTER_COL(width)   ((16 - (width)) / 2)
+
+#if DISPLAY_TIME_ONLY_BIG_DIGITS
+static const layout_item_t time_only_items[] = {
+    { 0, 0, ITEM_BIG_TIME, ALIGN_LEFT, 16, NULL },
+};
+#define TIME_ONLY_PERIOD_MS 60000
+#else
+static const layout_item_t time_only_items[] = {
+    { 0, CENTER_COL(8), ITEM_TIME, ALIGN_LEFT, 8, NULL },
+};
+#define TIME_ONLY_PERIOD_MS 1000
+#endif
+
+static const layout_item_t date_only_items[] = {
+    { 0, CENTER_COL(10), ITEM_DATE, ALIGN_LEFT, 10, NULL },
+};
+
+static const layout_item_t time_date_items[] = {
+    { 0, 0, ITEM_TIME, ALIGN_LEFT, 8,  NULL },
+    { 1, 0, ITEM_DATE, ALIGN_LEFT, 10, NULL },
+};
+
+static const layout_item_t time_weekday_items[] = {
+    { 0, 0, ITEM_TIME,    ALIGN_LEFT,   8,  NULL },
+    { 1, 0, ITEM_WEEKDAY, ALIGN_CENTER, 16, NULL },
+};
+
+static const layout_item_t full_items[] = {
+    { 0, 0,  ITEM_TIME,           ALIGN_LEFT, 8,  NULL },
+    { 0, 15, ITEM_ALARM_ICON,     ALIGN_LEFT, 1,  NULL },
+    { 1, 0,  ITEM_DATE,           ALIGN_LEFT, 10, NULL },
+    { 1, 11, ITEM_WEEKDAY_SCROLL, ALIGN_LEFT, 5, NULL },
+};
+
+static const layout_item_t alarm_focus_items[] = {
+    { 0, 0,  ITEM_HHMM,        ALIGN_LEFT, 5, NULL },   // Minute granularity
+    { 0, 15, ITEM_ALARM_STATE, ALIGN_LEFT, 1, NULL },
+    { 1, 0,  ITEM_LABEL,       ALIGN_LEFT, 7, "Alarm: " },
+    { 1, 7,  ITEM_ALARM_TIME,  ALIGN_LEFT, 5, NULL },
+};
+
+#define LAYOUT_DESC(items, period_ms) \
+    { (items), sizeof(items) / sizeof((items)[0]), (period_ms) }
+
+static const layout_desc_t layout_descs[LAYOUT_COUNT] = {
+    [LAYOUT_TIME_ONLY]    = LAYOUT_DESC(time_only_items,    TIME_ONLY_PERIOD_MS),
+    [LAYOUT_DATE_ONLY]    = LAYOUT_DESC(date_only_items,    60000),
+    [LAYOUT_TIME_DATE]    = LAYOUT_DESC(time_date_items,    1000),
+    [LAYOUT_TIME_WEEKDAY] = LAYOUT_DESC(time_weekday_items, 1000),
+    [LAYOUT_FULL]         = LAYOUT_DESC(full_items,         1000),
+    [LAYOUT_ALARM_FOCUS]  = LAYOUT_DESC(alarm_focus_items,  60000),
+};
 
 // ============================================
-// PUBLIC FUNCTIONS
+// BIG DIGITS
 // ============================================
 
-void display_init(void) {
-    // Load custom characters into LCD CGRAM
-    lcd_create_char(LCD_CUSTOM_BELL, bell_char);
-    lcd_create_char(LCD_CUSTOM_ALARM_ON, alarm_on_char);
-    lcd_create_char(LCD_CUSTOM_ALARM_OFF, alarm_off_char);
-    lcd_create_char(LCD_CUSTOM_CHECK, check_char);
-    lcd_create_char(LCD_CUSTOM_CROSS, cross_char);
-    lcd_create_char(LCD_CUSTOM_CLOCK, clock_char);
-    lcd_create_char(LCD_CUSTOM_CALENDAR, calendar_char);
-    lcd_create_char(LCD_CUSTOM_SETTINGS, settings_char);
-
-    // Initialize display state buffers with safe values
+// Each digit is 3x2 cells built from 7 segment glyphs; CELL_FULL is the
+// ROM solid block and CELL_BLANK a space. Values below GLYPH_COUNT are glyphs.
+#define CELL_FULL   0xFF
+#define CELL_BLANK  0xFE
+#define BIG_COLON   ((char)0xA5)    // ROM centred dot
+
+static const uint8_t big_digit_cells[10][2][3] = {
+    { { GLYPH_BIG_LT,  GLYPH_BIG_UB,  GLYPH_BIG_RT  }, { GLYPH_BIG_LL, GLYPH_BIG_LB, GLYPH_BIG_LR } },
+    { { GLYPH_BIG_UB,  GLYPH_BIG_RT,  CELL_BLANK    }, { GLYPH_BIG_LB, CELL_FULL,    GLYPH_BIG_LB } },
+    { { GLYPH_BIG_UMB, GLYPH_BIG_UMB, GLYPH_BIG_RT  }, { GLYPH_BIG_LL, GLYPH_BIG_LB, GLYPH_BIG_LB } },
+    { { GLYPH_BIG_UMB, GLYPH_BIG_UMB, GLYPH_BIG_RT  }, { GLYPH_BIG_LB, GLYPH_BIG_LB, GLYPH_BIG_LR } },
+    { { GLYPH_BIG_LL,  GLYPH_BIG_LB,  CELL_FULL     }, { CELL_BLANK,   CELL_BLANK,   CELL_FULL    } },
+    { { CELL_FULL,     GLYPH_BIG_UMB, GLYPH_BIG_UMB }, { GLYPH_BIG_LB, GLYPH_BIG_LB, GLYPH_BIG_LR } },
+    { { GLYPH_BIG_LT,  GLYPH_BIG_UMB, GLYPH_BIG_UMB }, { GLYPH_BIG_LL, GLYPH_BIG_LB, GLYPH_BIG_LR } },
+    { { GLYPH_BIG_UB,  GLYPH_BIG_UB,  GLYPH_BIG_RT  }, { CELL_BLANK,   CELL_BLANK,   CELL_FULL    } },
+    { { GLYPH_BIG_LT,  GLYPH_BIG_UMB, GLYPH_BIG_RT  }, { GLYPH_BIG_LL, GLYPH_BIG_LB, GLYPH_BIG_LR } },
+    { { GLYPH_BIG_LT,  GLYPH_BIG_UMB, GLYPH_BIG_RT  }, { CELL_BLANK,   CELL_BLANK,   CELL_FULL    } },
+};
+
+// H H : M M across the 16 columns: digits at 0/4/9/13, colon at 7
+static const uint8_t big_digit_col[4] = { 0, 4, 9, 13 };
+#define BIG_COLON_COL 7
+
+// ============================================
+// DDRAM PAGES
+// ============================================
+
+// Each DDRAM row is 40 columns; the display shows 16 of them. Page 0 is
+// columns 0-15 and page 1 is columns 16-31: the next layout is rendered
+// into the hidden page and shown by shifting the display window.
+#define PAGE_COUNT  2
+#define PAGE_ROWS   2
+#define PAGE_COLS   16
+
+// What one page holds: text, or a glyph ID where a custom char sits
+typedef struct {
+    char text[PAGE_ROWS][PAGE_COLS];
+    uint8_t glyph[PAGE_ROWS][PAGE_COLS];
+} page_frame_t;
+
+static page_frame_t frame;                      // Render target
+static page_frame_t page_shadow[PAGE_COUNT];    // What DDRAM holds
+static uint8_t visible_page = 0;
+static display_layout_t hidden_layout = LAYOUT_COUNT;   // LAYOUT_COUNT = none
+
+// ============================================
+// MARQUEE STATE
+// ============================================
+
+// Blank cells between the end of a scrolled string and its restart
+#define MARQUEE_GAP 3
+
+// Scroll position, advanced by the RTC wakeup subscriber (ISR)
+static volatile uint8_t scroll_step = 0;
+static uint8_t scroll_step_drawn = 0;
+static bool marquee_subscribed = false;
+
+// Scrolled field: offset into its period, advanced by the steps since
+// it was last drawn (the 8-bit step wraps at 256, not at the period)
+static uint8_t scroll_pos = 0;
+static uint8_t scroll_pos_step = 0;
+
+// Banner: text lives in DDRAM row 0; steps are display shifts
+static char banner_text[DISPLAY_MARQUEE_MAX + 1];
+static uint8_t banner_len = 0;
+static bool banner_active = false;
+static bool banner_written = false;
+
+// Next time update's frame, rendered ahead while the display is idle
+// and sent as-is when the model reaches next_time
+static page_frame_t next_frame;
+static char next_time[9];
+static bool next_ready = false;
+
+// ============================================
+// PRIVATE HELPER FUNCTIONS
+// ============================================
+
+static void frame_clear(void) {
+    memset(frame.text, ' ', sizeof(frame.text));
+    memset(frame.glyph, GLYPH_NONE, sizeof(frame.glyph));
+}
+
+static void frame_text_n(uint8_t row, uint8_t col, const char* str, uint8_t width) {
+    while (*str != '\0' && width-- > 0 && col < PAGE_COLS) {
+        frame.text[row][col] = *str++;
+        frame.glyph[row][col] = GLYPH_NONE;
+        col++;
+    }
+}
+
+static void frame_text(uint8_t row, uint8_t col, const char* str) {
+    frame_text_n(row, col, str, PAGE_COLS);
+}
+
+static void frame_glyph(uint8_t row, uint8_t col, glyph_id_t glyph) {
+    frame.text[row][col] = ' ';
+    frame.glyph[row][col] = glyph;
+}
+
+// Place one 3x2 big digit; the page diff later sends only cells that changed
+static void frame_big_digit(uint8_t col, char digit) {
+    if (digit < '0' || digit > '9') return;
+
+    for (uint8_t row = 0; row < 2; row++) {
+        for (uint8_t i = 0; i < 3; i++) {
+            uint8_t cell = big_digit_cells[digit - '0'][row][i];
+
+            if (cell < GLYPH_COUNT) {
+                frame_glyph(row, col + i, (glyph_id_t)cell);
+            } else {
+                frame.text[row][col + i] = (cell == CELL_FULL) ? (char)0xFF : ' ';
+            }
+        }
+    }
+}
+
+// Window of a string scrolled by the marquee step; the string restarts
+// after MARQUEE_GAP blanks
+static void frame_scroll_text(uint8_t row, uint8_t col, uint8_t width,
+                              const char* text, uint8_t len) {
+    uint8_t period = len + MARQUEE_GAP;
+    uint8_t steps = (uint8_t)(scroll_step - scroll_pos_step);
+
+    scroll_pos_step += steps;
+    scroll_pos = (uint8_t)((scroll_pos + steps) % period);
+    uint8_t start = scroll_pos;
+
+    for (uint8_t i = 0; i < width && col + i < PAGE_COLS; i++) {
+        uint8_t idx = (start + i) % period;
+        frame.text[row][col + i] = (idx < len) ? text[idx] : ' ';
+        frame.glyph[row][col + i] = GLYPH_NONE;
+    }
+}
+
+// HH:MM from the time buffer, two rows tall
+static void frame_big_time(void) {
+    const char* t = view.time_buffer;
+    const char digits[4] = { t[0], t[1], t[3], t[4] };
+
+    for (uint8_t i = 0; i < 4; i++) {
+        frame_big_digit(big_digit_col[i], digits[i]);
+    }
+    frame.text[0][BIG_COLON_COL] = BIG_COLON;
+    frame.text[1][BIG_COLON_COL] = BIG_COLON;
+}
+
+// Forget what DDRAM holds: the next flush rewrites every cell
+static void page_shadow_invalidate(void) {
+    memset(page_shadow, 0, sizeof(page_shadow));
+}
+
+typedef enum {
+    FLUSH_DONE,         // Page matches the frame
+    FLUSH_NO_SLOT,      // A glyph found no CGRAM slot (all protected)
+    FLUSH_OVER_BUDGET   // Stopped at the byte budget; shadow holds what was sent
+} flush_result_t;
+
+// Write the frame into a page, sending only cells that differ from it.
+// The shadow is updated cell by cell, so a flush cut short by the byte
+// budget (0 = none) resumes where it stopped on the next frame.
+static flush_result_t page_flush(uint8_t page, uint32_t budget) {
+    page_frame_t* shadow = &page_shadow[page];
+    uint8_t base = page * PAGE_COLS;
+    uint32_t start = display_backend_byte_count();
+
+    for (uint8_t row = 0; row < PAGE_ROWS; row++) {
+        uint8_t col = 0;
+
+        while (col < PAGE_COLS) {
+            bool same = frame.text[row][col] == shadow->text[row][col] &&
+                        frame.glyph[row][col] == shadow->glyph[row][col];
+            if (same) {
+                col++;
+                continue;
+            }
+
+            if (budget != 0 && display_backend_byte_count() - start >= budget) {
+                return FLUSH_OVER_BUDGET;
+            }
+
+            if (frame.glyph[row][col] != GLYPH_NONE) {
+                if (!display_backend_put_glyph(row, base + col, (glyph_id_t)frame.glyph[row][col])) {
+                    // Page is part-written - next flush rewrites all of it
+                    memset(shadow, 0, sizeof(*shadow));
+                    return FLUSH_NO_SLOT;
+                }
+                shadow->text[row][col] = frame.text[row][col];
+                shadow->glyph[row][col] = frame.glyph[row][col];
+                col++;
+                continue;
+            }
+
+            // Run of changed text cells: one cursor command, then chars
+            display_backend_set_cursor(row, base + col);
+            while (col < PAGE_COLS && frame.glyph[row][col] == GLYPH_NONE &&
+                   (frame.text[row][col] != shadow->text[row][col] ||
+                    shadow->glyph[row][col] != GLYPH_NONE)) {
+                display_backend_write_char(row, base + col, frame.text[row][col]);
+                shadow->text[row][col] = frame.text[row][col];
+                shadow->glyph[row][col] = GLYPH_NONE;
+                col++;
+
+                if (budget != 0 && display_backend_byte_count() - start >= budget) {
+                    break;
+                }
+            }
+        }
+    }
+
+    return FLUSH_DONE;
+}
+
+// Show the hidden page: a display shift, no DDRAM writes
+static void display_flip(void) {
+    next_ready = false;     // Prepared against the other page
+    visible_page ^= 1U;
+    display_backend_set_offset(visible_page * PAGE_COLS);
+    hidden_layout = LAYOUT_COUNT;
+}
+
+// Writer side of the seqlock. The ISR may preempt a main-loop writer,
+// but never one of the same field; the renderer only runs in the main
+// loop, so it never observes a nested write in progress.
+static void model_write_begin(void) {
+    model_seq++;
+    __DMB();    // Odd sequence visible before any model store
+}
+
+static void model_write_end(void) {
+    __DMB();    // Model stores complete before the sequence turns even
+    model_seq++;
+}
+
+// Set dirty bits with LDREX/STREX: an interrupt between the two
+// clears the exclusive monitor and the update is retried
+static void model_mark_dirty(uint8_t bits) {
+    volatile uint8_t* dirty = &display_state.dirty;
+    uint8_t value;
+
+    do {
+        value = __LDREXB(dirty);
+    } while (__STREXB(value | bits, dirty) != 0);
+}
+
+// Take and clear all dirty bits in one atomic step
+static uint8_t model_take_dirty(void) {
+    volatile uint8_t* dirty = &display_state.dirty;
+    uint8_t value;
+
+    do {
+        value = __LDREXB(dirty);
+    } while (__STREXB(0, dirty) != 0);
+
+    return value;
+}
+
+// Reader side: copy the model until no write overlapped the copy
+static void model_snapshot(void) {
+    uint32_t seq;
+
+    do {
+        seq = model_seq;
+        __DMB();
+        view = display_state;
+        view_weekday_len = weekday_len;
+        view_edge_cycles = time_edge_cycles;
+        __DMB();
+    } while ((seq & 1U) != 0 || seq != model_seq);
+}
+
+// Cycle counter for edge-to-glass latency
+static void cycle_counter_init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+// "HH:MM:SS" plus some seconds, wrapping at midnight
+static bool time_text_add(char* out, const char* hhmmss, uint32_t seconds) {
+    for (uint8_t i = 0; i < 8; i++) {
+        bool colon = (i == 2 || i == 5);
+        if (colon ? hhmmss[i] != ':' : (hhmmss[i] < '0' || hhmmss[i] > '9')) {
+            return false;
+        }
+    }
+
+    uint32_t t = (uint32_t)((hhmmss[0] - '0') * 10 + (hhmmss[1] - '0')) * 3600U +
+                 (uint32_t)((hhmmss[3] - '0') * 10 + (hhmmss[4] - '0')) * 60U +
+                 (uint32_t)((hhmmss[6] - '0') * 10 + (hhmmss[7] - '0'));
+    t = (t + seconds) % 86400U;
+
+    snprintf(out, 9, "%02u:%02u:%02u",
+             (unsigned)(t / 3600U), (unsigned)(t / 60U % 60U), (unsigned)(t % 60U));
+    return true;
+}
+
+// RTC wakeup subscriber (interrupt context): only advances the step;
+// the frame scheduler sends it
+static void marquee_tick(void) {
+    scroll_step++;
+    model_mark_dirty(DISPLAY_DIRTY_MARQUEE);
+}
+
+// Width of the layout's scrolled weekday, 0 if it has none
+static uint8_t layout_scroll_width(display_layout_t layout) {
+    const layout_desc_t* desc = &layout_descs[layout];
+
+    for (uint8_t i = 0; i < desc->count; i++) {
+        if (desc->items[i].kind == ITEM_WEEKDAY_SCROLL) {
+            return desc->items[i].width;
+        }
+    }
+    return 0;
+}
+
+// Tick only while something scrolls, so the RTC keeps its slow rate
+// otherwise; a weekday that fits its field is drawn still (main loop only)
+static void marquee_update_subscription(void) {
+    uint8_t width = layout_scroll_width(display_state.current_layout);
+    bool needed = banner_active || (width > 0 && weekday_len > width);
+
+    if (needed && !marquee_subscribed) {
+        marquee_subscribed = rtc_wakeup_subscribe(marquee_tick, DISPLAY_MARQUEE_STEP_MS, 0);
+    } else if (!needed && marquee_subscribed) {
+        rtc_wakeup_unsubscribe(marquee_tick);
+        marquee_subscribed = false;
+    }
+}
+
+// Initialize display state buffers with safe values
+static void display_init_model(void) {
+    // LCD init leaves the window at column 0; DDRAM content is unknown
+    visible_page = 0;
+    hidden_layout = LAYOUT_COUNT;
+    next_ready = false;
+    page_shadow_invalidate();
+    cycle_counter_init();
+
+    model_write_begin();
     strcpy(display_state.time_buffer, "00:00:00");
     strcpy(display_state.date_buffer, "01/01/2000");
     strcpy(display_state.weekday_buffer, "Monday");
     strcpy(display_state.alarm_time_buffer, "00:00");
+    weekday_len = 6;
+    model_write_end();
+
+    model_mark_dirty(DISPLAY_DIRTY_ALL);
+    marquee_update_subscription();
+}
+
+// Copy a model string, marking its field dirty only if it changed
+static void model_set_text(char* buffer, const char* str, uint8_t dirty_bit) {
+    if (strcmp(buffer, str) != 0) {
+        model_write_begin();
+        strcpy(buffer, str);
+        if (buffer == display_state.weekday_buffer) {
+            weekday_len = (uint8_t)strlen(str);
+        }
+        model_write_end();
+
+        model_mark_dirty(dirty_bit);
+    }
+}
+
+static void model_set_flag(bool* flag, bool value) {
+    if (*flag != value) {
+        model_write_begin();
+        *flag = value;
+        model_write_end();
+
+        model_mark_dirty(DISPLAY_DIRTY_ALARM);
+    }
+}
+
+// ============================================
+// PUBLIC FUNCTIONS
+// ============================================
+
+void display_init(void) {
+    // CGRAM is empty - glyphs are uploaded on first use
+    display_backend_glyphs_init(false);
+    display_init_model();
+}
+
+void display_init_warm(void) {
+    // CGRAM survived the reset - pick up what the last run loaded
+    display_backend_glyphs_init(true);
+    display_init_model();
 }
 
 void display_set_layout(display_layout_t layout) {
     if (layout != display_state.current_layout && layout < LAYOUT_COUNT) {
+        // Pre-rendered: just flip; the next refresh fixes any cells the
+        // model changed since (usually the seconds). A banner owns the
+        // display shift - the layout is drawn when it stops.
+        if (layout == hidden_layout && !banner_active) {
+            display_flip();
+        }
         display_state.current_layout = layout;
+        model_mark_dirty(DISPLAY_DIRTY_LAYOUT);
+        marquee_update_subscription();
     }
 }
 
 void display_update_time(const char* time_str) {
     if (time_str != NULL && strlen(time_str) <= 8) {
-        strcpy(display_state.time_buffer, time_str);
+        // Called from the RTC wakeup ISR: back-date the stamp to the
+        // second edge using the subsecond counter
+        uint32_t since_edge = rtc_get_subsecond_us() * (SystemCoreClock / 1000000U);
+        uint32_t edge = DWT->CYCCNT - since_edge;
+
+        if (strcmp(display_state.time_buffer, time_str) != 0) {
+            model_write_begin();
+            time_edge_cycles = edge;
+            model_write_end();
+        }
+        model_set_text(display_state.time_buffer, time_str, DISPLAY_DIRTY_TIME);
     }
 }
 
 void display_update_date(const char* date_str) {
     if (date_str != NULL && strlen(date_str) <= 10) {
-        strcpy(display_state.date_buffer, date_str);
+        model_set_text(display_state.date_buffer, date_str, DISPLAY_DIRTY_DATE);
     }
 }
 
 void display_update_weekday(const char* weekday_str) {
     if (weekday_str != NULL && strlen(weekday_str) < sizeof(display_state.weekday_buffer)) {
-        strcpy(display_state.weekday_buffer, weekday_str);
+        model_set_text(display_state.weekday_buffer, weekday_str, DISPLAY_DIRTY_WEEKDAY);
+        marquee_update_subscription();
     }
 }
 
 void display_show_alarm_icon(bool show) {
-    display_state.alarm_icon_visible = show;
+    model_set_flag(&display_state.alarm_icon_visible, show);
 }
 
 void display_set_alarm_status(bool enabled, bool triggered) {
-    display_state.alarm_enabled = enabled;
-    display_state.alarm_triggered = triggered;
+    model_set_flag(&display_state.alarm_enabled, enabled);
+    model_set_flag(&display_state.alarm_triggered, triggered);
 }
 
 void display_set_alarm_time(const char* alarm_time_str) {
     if (alarm_time_str != NULL && strlen(alarm_time_str) <= 5) {
-        strcpy(display_state.alarm_time_buffer, alarm_time_str);
+        model_set_text(display_state.alarm_time_buffer, alarm_time_str,
+                       DISPLAY_DIRTY_ALARM_TIME);
     }
 }
 
-// ============================================
-// DISPLAY REFRESH FUNCTION (SIMPLE!)
-// ============================================
+void display_update_field(display_field_t field, uint8_t value) {
+    if (field >= DISPLAY_FIELD_COUNT || value > 99) return;
 
-void display_refresh(void) {
-    lcd_clear();
+    const field_location_t* loc = &field_location[field];
+    char* digits = &loc->buffer[loc->offset];
+    char tens = (char)('0' + value / 10);
+    char ones = (char)('0' + value % 10);
 
-    switch (display_state.current_layout) {
-        case LAYOUT_TIME_ONLY:
-            // Time only (centered)
-            lcd_set_cursor(0, (16 - strlen(display_state.time_buffer)) / 2);
-            lcd_write_string(display_state.time_buffer);
-            break;
+    if (digits[0] == tens && digits[1] == ones) return;
 
-        case LAYOUT_DATE_ONLY:
-            // Date only (centered)
-            lcd_set_cursor(0, (16 - strlen(display_state.date_buffer)) / 2);
-            lcd_write_string(display_state.date_buffer);
-            break;
+    model_write_begin();
+    digits[0] = tens;
+    digits[1] = ones;
+    model_write_end();
 
-        case LAYOUT_TIME_DATE:
-            // Line 1: Time
-            lcd_set_cursor(0, 0);
-            lcd_write_string(display_state.time_buffer);
+    // The next frame's page diff sends only the two changed characters
+    model_mark_dirty((loc->buffer == display_state.time_buffer) ?
+                     DISPLAY_DIRTY_TIME : DISPLAY_DIRTY_DATE);
+}
 
-            // Line 2: Date
-            lcd_set_cursor(1, 0);
-            lcd_write_string(display_state.date_buffer);
-            break;
+// ============================================
+// LAYOUT RENDERING (into the frame, no I2C)
+// ============================================
+
+// Draw one descriptor item into the frame
+static void render_item(const layout_item_t* item) {
+    const char* text = NULL;
+    uint8_t col = item->col;
 
-        case LAYOUT_TIME_WEEKDAY:
-            // Line 1: Time
-            lcd_set_cursor(0, 0);
-            lcd_write_string(display_state.time_buffer);
+    switch (item->kind) {
+        case ITEM_TIME:
+        case ITEM_HHMM:       text = view.time_buffer;       break;
+        case ITEM_DATE:       text = view.date_buffer;       break;
+        case ITEM_WEEKDAY:    text = view.weekday_buffer;    break;
 
-            // Line 2: Weekday (centered)
-            lcd_set_cursor(1, (16 - strlen(display_state.weekday_buffer)) / 2);
-            lcd_write_string(display_state.weekday_buffer);
+        case ITEM_WEEKDAY_SCROLL:
+            if (view_weekday_len > item->width) {
+                frame_scroll_text(item->row, col, item->width,
+                                  view.weekday_buffer, view_weekday_len);
+                return;
+            }
+            text = view.weekday_buffer;
             break;
 
-        case LAYOUT_FULL:
-            // Line 1: Time + Alarm icon
-            lcd_set_cursor(0, 0);
-            lcd_write_string(display_state.time_buffer);
+        case ITEM_ALARM_TIME: text = view.alarm_time_buffer; break;
+        case ITEM_LABEL:      text = item->label;                     break;
+
+        case ITEM_BIG_TIME:
+            frame_big_time();
+            return;
 
-            if (display_state.alarm_icon_visible) {
-                lcd_set_cursor(0, 15);
-                if (display_state.alarm_enabled) {
-                    lcd_write_custom_char(LCD_CUSTOM_ALARM_ON);
+        case ITEM_ALARM_ICON:
+            if (view.alarm_icon_visible) {
+                frame_glyph(item->row, col, view.alarm_enabled ?
+                               GLYPH_ALARM_ON : GLYPH_ALARM_OFF);
+            }
+            return;
+
+        case ITEM_ALARM_STATE:
+            if (view.alarm_icon_visible) {
+                if (view.alarm_triggered) {
+                    frame_glyph(item->row, col, GLYPH_ALARM_ON);
+                } else if (view.alarm_enabled) {
+                    frame_glyph(item->row, col, GLYPH_BELL);
                 } else {
-                    lcd_write_custom_char(LCD_CUSTOM_ALARM_OFF);
+                    frame_glyph(item->row, col, GLYPH_ALARM_OFF);
                 }
             }
+            return;
 
-            // Line 2: Date + Weekday (abbreviated)
-            draw_full_layout_line2();
-            break;
+        default:
+            return;
+    }
 
-        case LAYOUT_ALARM_FOCUS:
-            // Line 1: Time + Bell icon
-            lcd_set_cursor(0, 0);
-            lcd_write_string(display_state.time_buffer);
-
-            if (display_state.alarm_icon_visible) {
-                lcd_set_cursor(0, 15);
-                if (display_state.alarm_triggered) {
-                    lcd_write_custom_char(LCD_CUSTOM_ALARM_ON);
-                } else if (display_state.alarm_enabled) {
-                    lcd_write_custom_char(LCD_CUSTOM_BELL);
-                } else {
-                    lcd_write_custom_char(LCD_CUSTOM_ALARM_OFF);
-                }
+    // Fixed-width fields are placed by the table; only the weekday
+    // varies in length, and that length is cached
+    if (item->align == ALIGN_CENTER) {
+        uint8_t len = (item->kind == ITEM_WEEKDAY) ? view_weekday_len : item->width;
+        if (len < item->width) {
+            col += (item->width - len) / 2;
+        }
+    }
+    frame_text_n(item->row, col, text, item->width);
+}
+
+// Blank the cells an item owns before it is redrawn
+static void frame_clear_item(const layout_item_t* item) {
+    if (item->kind == ITEM_BIG_TIME) {
+        frame_clear();
+        return;
+    }
+
+    for (uint8_t col = item->col; col < item->col + item->width && col < PAGE_COLS; col++) {
+        frame.text[item->row][col] = ' ';
+        frame.glyph[item->row][col] = GLYPH_NONE;
+    }
+}
+
+static void render_layout(display_layout_t layout) {
+    frame_clear();
+
+    if (layout >= LAYOUT_COUNT) {
+        // Invalid layout - show error
+        frame_text(0, 0, "Invalid Layout");
+        return;
+    }
+
+    const layout_desc_t* desc = &layout_descs[layout];
+
+    for (uint8_t i = 0; i < desc->count; i++) {
+        render_item(&desc->items[i]);
+    }
+}
+
+// Start from what the page holds and redraw only the items whose
+// field is dirty; everything else is left untouched
+static void render_dirty_items(display_layout_t layout, uint8_t dirty) {
+    const layout_desc_t* desc = &layout_descs[layout];
+
+    frame = page_shadow[visible_page];
+
+    for (uint8_t i = 0; i < desc->count; i++) {
+        const layout_item_t* item = &desc->items[i];
+
+        if (item_dirty_bit[item->kind] & dirty) {
+            frame_clear_item(item);
+            render_item(item);
+        }
+    }
+}
+
+// ============================================
+// MARQUEE
+// ============================================
+
+// Banner frame: write the text once, then one display shift per step.
+// The text starts at column 16 so it scrolls in from the right edge.
+static void banner_render(void) {
+    if (!banner_written) {
+        display_backend_clear();
+
+        for (uint8_t i = 0; i < banner_len; i++) {
+            uint8_t col = (uint8_t)((PAGE_COLS + i) % DISPLAY_BACKEND_COLS);
+
+            // Wrap past column 39 needs a new address
+            if (i == 0 || col == 0) {
+                display_backend_set_cursor(0, col);
             }
+            display_backend_write_char(0, col, banner_text[i]);
+        }
 
-            // Line 2: Alarm time
-            lcd_set_cursor(1, 0);
-            lcd_write_string("Alarm: ");
-            lcd_write_string(display_state.alarm_time_buffer);
-            break;
+        banner_written = true;
+        scroll_step_drawn = scroll_step;
+        return;
+    }
 
-        default:
-            // Invalid layout - show error
-            lcd_set_cursor(0, 0);
-            lcd_write_string("Invalid Layout");
-            display_state.current_layout = LAYOUT_TIME_DATE;
-            break;
+    // A late frame catches up with one shift per missed step
+    uint8_t steps = (uint8_t)(scroll_step - scroll_step_drawn);
+    scroll_step_drawn += steps;
+
+    uint8_t offset = (uint8_t)((display_backend_get_offset() + steps) % DISPLAY_BACKEND_COLS);
+    display_backend_set_offset(offset);
+}
+
+void display_marquee_start(const char* text) {
+    if (text == NULL) return;
+
+    uint8_t len = 0;
+    while (text[len] != '\0' && len < DISPLAY_MARQUEE_MAX) {
+        banner_text[len] = text[len];
+        len++;
     }
+    banner_text[len] = '\0';
+
+    banner_len = len;
+    banner_written = false;
+    banner_active = true;
+
+    // The shift moves both rows and both pages: page flipping is off
+    hidden_layout = LAYOUT_COUNT;
+    next_ready = false;
+
+    model_mark_dirty(DISPLAY_DIRTY_MARQUEE);
+    marquee_update_subscription();
+}
+
+void display_marquee_stop(void) {
+    if (!banner_active) return;
+
+    banner_active = false;
+    marquee_update_subscription();
+
+    // The banner left the window anywhere and DDRAM full of text: start
+    // the pages over from a cleared screen
+    display_backend_clear();
+    visible_page = 0;
+    page_shadow_invalidate();
+    model_mark_dirty(DISPLAY_DIRTY_LAYOUT);
+}
+
+bool display_marquee_active(void) {
+    return banner_active;
+}
+
+// ============================================
+// DISPLAY REFRESH / PAGE FLIP
+// ============================================
+
+// Render and flush the merged dirty fields; false if cut short by
+// the byte budget (the rest goes out next frame)
+static bool display_render_frame(uint32_t budget) {
+    if (display_state.current_layout >= LAYOUT_COUNT) {
+        display_state.current_layout = LAYOUT_TIME_DATE;
+        model_mark_dirty(DISPLAY_DIRTY_LAYOUT);
+    }
+
+    uint8_t hidden = visible_page ^ 1U;
+    uint8_t dirty = model_take_dirty();
+    uint32_t evictions;
+
+    if (dirty == 0) return true;
+    refreshed_mask = dirty;
+
+    // Layout changes wait for the banner to stop (which redraws anyway)
+    if (banner_active) {
+        banner_render();
+        return true;
+    }
+
+    // Draw from a consistent copy; writes after this are next frame's
+    model_snapshot();
+
+    // Re-render the visible page; only changed cells go over I2C, so
+    // nothing is cleared and nothing tears. Any slot may be reused.
+    display_backend_protect(0, 0);
+    evictions = display_backend_glyph_evictions();
+
+    // Prepared frame still matches: no rendering between edge and flush
+    bool prepared = next_ready && dirty == DISPLAY_DIRTY_TIME &&
+                    strcmp(view.time_buffer, next_time) == 0;
+    next_ready = false;
+
+    if (prepared) {
+        frame = next_frame;
+        frame_stats.prepared++;
+    } else if (dirty & DISPLAY_DIRTY_LAYOUT) {
+        render_layout(display_state.current_layout);
+    } else {
+        render_dirty_items(display_state.current_layout, dirty);
+    }
+
+    flush_result_t result = page_flush(visible_page, budget);
+
+    // Edge-to-glass: RTC second edge to the last byte of its frame
+    if ((dirty & DISPLAY_DIRTY_TIME) && result == FLUSH_DONE) {
+        uint32_t cycles = DWT->CYCCNT - view_edge_cycles;
+        uint32_t us = cycles / (SystemCoreClock / 1000000U);
+
+        frame_stats.last_edge_latency_us = us;
+        if (us > frame_stats.max_edge_latency_us) {
+            frame_stats.max_edge_latency_us = us;
+        }
+    }
+    if (result == FLUSH_NO_SLOT) {
+        // Shadow was dropped - redraw everything next time
+        model_mark_dirty(DISPLAY_DIRTY_LAYOUT);
+    } else if (result == FLUSH_OVER_BUDGET) {
+        // Re-render the same items next frame; the diff sends the rest
+        model_mark_dirty(dirty);
+    }
+
+    // Cells whose glyph was evicted while drawing this frame
+    display_backend_redraw_stale(visible_page * PAGE_COLS, PAGE_COLS);
+
+    // An eviction may have changed a glyph on the hidden page too:
+    // that page can no longer be flipped to as-is
+    if (display_backend_glyph_evictions() != evictions && hidden_layout != LAYOUT_COUNT) {
+        hidden_layout = LAYOUT_COUNT;
+        memset(&page_shadow[hidden], 0, sizeof(page_shadow[hidden]));
+    }
+
+    return result != FLUSH_OVER_BUDGET;
+}
+
+void display_refresh(void) {
+    // Immediate, unbudgeted (first frame after bring-up)
+    display_render_frame(0);
+}
+
+void display_prerender(display_layout_t layout) {
+    if (layout >= LAYOUT_COUNT || banner_active) return;
+
+    uint8_t hidden = visible_page ^ 1U;
+
+    // Never steal a slot the visible page shows (big digits use 7 of 8):
+    // if the layout doesn't fit, it is drawn on the flip instead
+    display_backend_protect(visible_page * PAGE_COLS, PAGE_COLS);
+    model_snapshot();
+
+    render_layout(layout);
+    bool fits = (page_flush(hidden, 0) == FLUSH_DONE);
+
+    display_backend_protect(0, 0);
+    hidden_layout = fits ? layout : LAYOUT_COUNT;
+}
+
+// ============================================
+// FRAME SCHEDULER
+// ============================================
+
+// Render the frame for the next time update (one update period ahead)
+// into next_frame; CPU only, no I2C
+static void display_prepare_next_frame(void) {
+    uint32_t period_s = display_get_update_period_ms() / 1000U;
+
+    if (banner_active) return;
+
+    // Don't start if the edge will beat us to it
+    if (period_s == 1 && rtc_get_subsecond_us() > 1000000U - DISPLAY_PREPARE_GUARD_US) {
+        return;
+    }
+
+    model_snapshot();
+    if (!time_text_add(next_time, view.time_buffer, period_s)) {
+        return;
+    }
+
+    memcpy(view.time_buffer, next_time, sizeof(next_time));
+    render_dirty_items(display_state.current_layout, DISPLAY_DIRTY_TIME);
+    next_frame = frame;
+    next_ready = true;
+}
+
+bool display_frame_poll(void) {
+    uint32_t now = systick_get_ticks();
+
+    // Backends that send asynchronously move on with the last frame
+    display_backend_poll();
+
+    if ((int32_t)(now - next_frame_ms) < 0) return false;
+
+    if (display_state.dirty == 0) {
+        // Idle: keep the boundary due so the next change renders at once,
+        // and get the next second's frame ready for it
+        next_frame_ms = now;
+        if (!next_ready) {
+            display_prepare_next_frame();
+        }
+        return false;
+    }
+
+    // Whole periods the main loop overran while content was waiting
+    frame_stats.dropped += (now - next_frame_ms) / frame_period_ms;
+    next_frame_ms = now + frame_period_ms;
+
+    uint32_t bytes = display_backend_byte_count();
+    bool complete = display_render_frame(frame_budget);
+    uint32_t frame_ms = systick_get_ticks() - now;
+    bytes = display_backend_byte_count() - bytes;
+
+    frame_stats.frames++;
+    if (!complete) {
+        frame_stats.over_budget++;
+    }
+    frame_stats.last_frame_ms = frame_ms;
+    if (frame_ms > frame_stats.max_frame_ms) {
+        frame_stats.max_frame_ms = frame_ms;
+    }
+    frame_stats.last_frame_bytes = bytes;
+    if (bytes > frame_stats.max_frame_bytes) {
+        frame_stats.max_frame_bytes = bytes;
+    }
+    return true;
+}
+
+void display_set_frame_rate(uint8_t max_fps) {
+    if (max_fps != 0) {
+        frame_period_ms = 1000U / max_fps;
+    }
+}
+
+void display_set_frame_budget(uint32_t i2c_bytes) {
+    frame_budget = i2c_bytes;
+}
+
+void display_get_frame_stats(display_frame_stats_t* stats) {
+    if (stats != NULL) {
+        *stats = frame_stats;
+    }
+}
+
+void display_reset_frame_stats(void) {
+    memset(&frame_stats, 0, sizeof(frame_stats));
 }
 
 // ============================================
@@ -196,10 +1034,30 @@ display_layout_t display_get_current_layout(void) {
     return display_state.current_layout;
 }
 
+uint32_t display_get_layout_update_period_ms(display_layout_t layout) {
+    return (layout < LAYOUT_COUNT) ? layout_descs[layout].update_period_ms : 1000;
+}
+
+uint32_t display_get_update_period_ms(void) {
+    return display_get_layout_update_period_ms(display_state.current_layout);
+}
+
 void display_next_layout(void) {
-    display_state.current_layout = (display_state.current_layout + 1) % LAYOUT_COUNT;
+    display_set_layout((display_layout_t)((display_state.current_layout + 1) % LAYOUT_COUNT));
 }
 
 const display_state_t* display_get_state(void) {
     return &display_state;
 }
+
+uint8_t display_get_dirty_mask(void) {
+    return display_state.dirty;
+}
+
+uint8_t display_get_refreshed_mask(void) {
+    return refreshed_mask;
+}
+
+bool display_flush_pending(void) {
+    return display_backend_pending();
+}
@@ -1,8 +1,11 @@
 #include "systick.h"
-#include "lcd1602_i2c.h"
+#include "display_backend.h"
 #include "i2c.h"
 #include "rtc.h"
 #include "display_manager.h"
+#include "button.h"
+#include "state_machine.h"
+#include "reset.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -12,17 +15,21 @@ typedef struct {
     uint8_t current_layout;
     bool alarm_enabled;
     bool alarm_triggered;
-    bool display_updated;  // Flag to indicate display needs refresh
 } app_state_t;
 
+// Boot-to-first-frame time (ms since reset), read with the debugger
+volatile uint32_t boot_to_first_frame_ms = 0;
+
 static app_state_t app_state = {
     .layout_change_time = 0,
     .current_layout = 0,
     .alarm_enabled = true,
-    .alarm_triggered = false,
-    .display_updated = false
+    .alarm_triggered = false
 };
 
+// Menu/edit state, fed from the button event queue
+static state_machine_t state_machine;
+
 // ============================================
 // TIME/DATE FORMATTING FUNCTIONS
 // ============================================
@@ -49,6 +56,9 @@ static void format_date_from_rtc(char* buffer, size_t buffer_size) {
 // UPDATE DISPLAY FROM RTC
 // ============================================
 
+// Runs only in the RTC wakeup interrupt, so the time and date in the
+// display model have a single writer; main-loop code asks for a run with
+// rtc_wakeup_trigger() instead of calling it
 static void update_display_from_rtc(void) {
     char time_str[12];
     char date_str[15];
@@ -57,18 +67,34 @@ static void update_display_from_rtc(void) {
     format_time_from_rtc(time_str, sizeof(time_str));
     format_date_from_rtc(date_str, sizeof(date_str));
 
-    // Update display model
+    // Update display model (marks only fields that changed as dirty)
     display_update_time(time_str);
     display_update_date(date_str);
+}
+
+// ============================================
+// ADAPTIVE WAKEUP RATE
+// ============================================
 
-    // Mark display for refresh
-    app_state.display_updated = true;
+// Wake only as often as the visible layout can change
+static void apply_layout_update_rate(void) {
+    rtc_wakeup_subscribe(update_display_from_rtc, display_get_update_period_ms(), 0);
 }
 
 // ============================================
 // AUTOMATIC LAYOUT CYCLING
 // ============================================
 
+// Layout shown by each cycle step (matches the switch below)
+static const display_layout_t layout_cycle[6] = {
+    LAYOUT_TIME_ONLY,
+    LAYOUT_DATE_ONLY,
+    LAYOUT_TIME_DATE,
+    LAYOUT_TIME_WEEKDAY,
+    LAYOUT_FULL,
+    LAYOUT_ALARM_FOCUS
+};
+
 static void cycle_layouts(void) {
     uint32_t current_time = systick_get_ticks();
 
@@ -106,49 +132,78 @@ static void cycle_layouts(void) {
         app_state.current_layout = (app_state.current_layout + 1) % 6;
         app_state.layout_change_time = current_time;
 
-        // Layout change needs display refresh
-        app_state.display_updated = true;
+        // Coarse layouts may hold a model up to a minute old
+        apply_layout_update_rate();
+        rtc_wakeup_trigger(update_display_from_rtc);
+
+        // Draw the next step off-screen so its switch is a page flip
+        display_prerender(layout_cycle[app_state.current_layout]);
     }
 }
 
 // ============================================
-// RTC PERIODIC CALLBACK (Called from interrupt)
+// MAIN APPLICATION WITH PERIODIC INTERRUPT
 // ============================================
 
-void rtc_periodic_callback(void) {
-    update_display_from_rtc();  // Updates data and sets flag
-}
-
 // ============================================
-// MAIN APPLICATION WITH PERIODIC INTERRUPT
+// DISPLAY BRING-UP (runs while the display powers up)
 // ============================================
 
+// Advance display init; on completion upload CGRAM and draw the first frame
+static bool display_bring_up(void) {
+    if (!display_backend_init_poll()) {
+        return false;
+    }
+
+    display_backend_power_on();
+
+    // Warm reset: glyphs are still in CGRAM
+    if (reset_is_warm()) {
+        display_init_warm();
+    } else {
+        display_init();
+    }
+    reset_set_display_marker(true);
+
+    // Subscribed before the main loop: the model is current on return
+    rtc_wakeup_trigger(update_display_from_rtc);
+    display_refresh();
+
+    boot_to_first_frame_ms = systick_get_ticks();
+
+    // First cycle step goes to the hidden page
+    display_prerender(layout_cycle[app_state.current_layout]);
+    return true;
+}
+
 int main(void) {
     // Initialize hardware
     systick_init();
+    reset_init();
     i2c_init();
-    lcd_init();
-    lcd_backlight_on();
 
-    // Initialize display manager
-    display_init();
+    // Display init advances from the main loop - the rest of the system
+    // comes up during its power-up and command waits. After a warm
+    // reset the LCD is still configured and only needs a re-sync.
+    display_backend_init_start(reset_is_warm());
 
-    // Initialize RTC
+    // Initialize RTC (keeps running across warm resets) and buttons.
+    // The state machine picks the repeat mask (none outside edit mode)
+    // before the button driver starts producing events.
     rtc_init();
+    state_machine_init(&state_machine);
+    button_init();
 
-    // Startup message
-    lcd_clear();
-    lcd_set_cursor(0, 0);
-    lcd_write_string("RTC Clock");
-    lcd_set_cursor(1, 0);
-    lcd_write_string("Starting...");
-    systick_delay_ms(2000);
-    lcd_clear();
+    // Invalid until bring-up completes: a reset before then boots cold
+    reset_set_display_marker(false);
 
     // Setup RTC periodic interrupt (every second)
     rtc_periodic_init(RTC_PERIODIC_EVERY_SECOND);
     rtc_periodic_enable();
 
+    // Display model follows the RTC (called from interrupt)
+    apply_layout_update_rate();
+
 
 
     // Initial display setup
@@ -156,29 +211,34 @@ int main(void) {
     display_show_alarm_icon(true);
     display_set_alarm_status(app_state.alarm_enabled, app_state.alarm_triggered);
 
-    // Get initial time
-    update_display_from_rtc();
-
-    // Initial refresh
-    display_refresh();
-    app_state.display_updated = false;
-
     // Main loop
     while (1) {
-
+        // 0. Finish display bring-up before drawing anything
+        if (!display_backend_ready()) {
+            display_bring_up();
+            continue;
+        }
 
         // 1. Auto-cycle layouts every 5 seconds
         cycle_layouts();
 
-
-
-        // 3. Refresh display if updated
-        if (app_state.display_updated) {
-            display_refresh();  // Simple refresh - no partial/full complexity
-            app_state.display_updated = false;
+        // 2. Button gestures drive the menu and edit the RTC fields
+        button_event_info_t event;
+        while (button_poll_event(&event)) {
+            state_machine_process_button(&state_machine, &event);
         }
 
-        // 4. Small delay
-        systick_delay_ms(10);
+        // 3. One render per frame boundary for everything that changed
+        display_frame_poll();
+
+        // 4. Sleep up to 10 ms; the RTC edge that dirties the model
+        //    ends it early so the prepared frame goes out at once, and
+        //    so do the end of an asynchronous backend transfer and a
+        //    queued button event
+        uint32_t sleep_start = systick_get_ticks();
+        while (!systick_delay_elapsed(sleep_start, 10) && display_get_dirty_mask() == 0 &&
+               !display_flush_pending() && !button_event_pending()) {
+            __WFI();
+        }
     }
 }
@@ -1,21 +1,149 @@
 #include "state_machine.h"
+#include "rtc.h"
+#include "board_config.h"
 #include <stddef.h>
 
+// Editable RTC fields, indexed by menu_index
+static const struct {
+    display_field_t field;
+    uint8_t min;
+    uint8_t max;
+} edit_fields[] = {
+    { DISPLAY_FIELD_HOURS,   0, 23 },
+    { DISPLAY_FIELD_MINUTES, 0, 59 },
+    { DISPLAY_FIELD_DAY,     1, 31 },
+    { DISPLAY_FIELD_MONTH,   1, 12 },
+};
+
+#define EDIT_FIELD_COUNT (sizeof(edit_fields) / sizeof(edit_fields[0]))
+
+// Days in a month of 2000-2099 (every fourth year is a leap year there)
+static uint8_t days_in_month(uint8_t month, uint16_t year) {
+    static const uint8_t days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    if (month < 1 || month > 12) return 31;
+    return (month == 2 && (year % 4U) == 0) ? 29 : days[month - 1];
+}
+
+// Largest value of a field; DAY depends on the month being edited
+static uint8_t edit_field_max(uint8_t menu_index) {
+    if (edit_fields[menu_index].field == DISPLAY_FIELD_DAY) {
+        rtc_date_t date;
+        rtc_get_date(&date);
+        return days_in_month(date.month, date.year);
+    }
+    return edit_fields[menu_index].max;
+}
+
+// Edit direction of a button: HOUR steps up, MIN steps down
+static int8_t edit_direction(button_id_t id) {
+    switch (id) {
+        case BUTTON_HOUR: return 1;
+        case BUTTON_MIN:  return -1;
+        default:          return 0;
+    }
+}
+
+static uint8_t edit_read_rtc(display_field_t field) {
+    rtc_time_t time;
+    rtc_date_t date;
+
+    rtc_get_time(&time);
+    rtc_get_date(&date);
+
+    switch (field) {
+        case DISPLAY_FIELD_HOURS:   return time.hours;
+        case DISPLAY_FIELD_MINUTES: return time.minutes;
+        case DISPLAY_FIELD_DAY:     return date.day;
+        case DISPLAY_FIELD_MONTH:   return date.month;
+        default:                    return 0;
+    }
+}
+
+// Write one field to the RTC; a month change pulls the day back into
+// the new month. Returns false if the RTC rejected the write.
+static bool edit_write_rtc(display_field_t field, uint8_t value) {
+    rtc_time_t time;
+    rtc_date_t date;
+
+    if (field == DISPLAY_FIELD_HOURS || field == DISPLAY_FIELD_MINUTES) {
+        rtc_get_time(&time);
+        if (field == DISPLAY_FIELD_HOURS) time.hours = value;
+        else                              time.minutes = value;
+        return rtc_set_time(&time);
+    }
+
+    rtc_get_date(&date);
+    if (field == DISPLAY_FIELD_DAY) {
+        date.day = value;
+    } else {
+        date.month = value;
+        uint8_t last_day = days_in_month(date.month, date.year);
+        if (date.day > last_day) {
+            date.day = last_day;
+        }
+    }
+    if (!rtc_set_date(&date)) {
+        return false;
+    }
+
+    if (field == DISPLAY_FIELD_MONTH) {
+        display_update_field(DISPLAY_FIELD_DAY, date.day);
+    }
+    return true;
+}
+
+// Step the edited value with wrap-around, write it to the RTC and
+// redraw only its two digits
+static void edit_step(state_machine_t* sm, bool up) {
+    uint8_t min = edit_fields[sm->menu_index].min;
+    uint8_t max = edit_field_max(sm->menu_index);
+    uint8_t value = sm->edit_value;
+
+    if (value > max) {
+        value = max;    // Month got shorter since the edit started
+    }
+
+    if (up) {
+        value = (value >= max) ? min : value + 1;
+    } else {
+        value = (value <= min) ? max : value - 1;
+    }
+
+    // Screen keeps the old digits if the RTC did not take the value
+    if (!edit_write_rtc(sm->edit_field, value)) {
+        sm->display_update_needed = false;
+        return;
+    }
+
+    sm->edit_value = value;
+    display_update_field(sm->edit_field, sm->edit_value);
+
+    // Digits already on screen - no full refresh
+    sm->display_update_needed = false;
+}
+
 void state_machine_init(state_machine_t* sm) {
     if (sm == NULL) return;
 
     sm->current_state = STATE_STANDARD;
     sm->menu_index = 0;
     sm->edit_value = 0;
+    sm->edit_field = DISPLAY_FIELD_HOURS;
     sm->display_update_needed = true;
+
+    // Auto-repeat only while a value is being edited
+    button_set_repeat_mask(0);
 }
 
-void state_machine_process_button(state_machine_t* sm, button_event_t btn_event) {
-    if (sm == NULL) return;
+void state_machine_process_button(state_machine_t* sm, const button_event_info_t* btn) {
+    if (sm == NULL || btn == NULL) return;
+
+    int8_t direction = edit_direction(btn->id);
 
     sm->display_update_needed = true;
 
-    switch (btn_event) {
+    switch (btn->event) {
         case BUTTON_EVENT_SHORT_PRESS:
             switch (sm->current_state) {
                 case STATE_STANDARD:
@@ -24,11 +152,15 @@ void state_machine_process_button(state_machine_t* sm, button_event_t btn_event)
                     break;
 
                 case STATE_MENU:
-                    sm->menu_index = (sm->menu_index + 1) % 4;
+                    sm->menu_index = (sm->menu_index + 1) % EDIT_FIELD_COUNT;
                     break;
 
                 case STATE_EDIT:
-                    sm->edit_value = (sm->edit_value + 1) % 100;
+                    if (direction != 0) {
+                        edit_step(sm, direction > 0);
+                    } else {
+                        sm->display_update_needed = false;
+                    }
                     break;
 
                 default:
@@ -41,11 +173,15 @@ void state_machine_process_button(state_machine_t* sm, button_event_t btn_event)
             switch (sm->current_state) {
                 case STATE_MENU:
                     sm->current_state = STATE_EDIT;
-                    sm->edit_value = 0;
+                    sm->edit_field = edit_fields[sm->menu_index].field;
+                    sm->edit_value = edit_read_rtc(sm->edit_field);
+                    button_set_repeat_mask(BUTTON_REPEAT_MASK_DEFAULT);
                     break;
 
                 case STATE_EDIT:
-                    sm->edit_value = (sm->edit_value > 0) ? sm->edit_value - 1 : 99;
+                    // HOUR/MIN repeat while held and never long-press;
+                    // the other buttons do not edit
+                    sm->display_update_needed = false;
                     break;
 
                 default:
@@ -62,6 +198,7 @@ void state_machine_process_button(state_machine_t* sm, button_event_t btn_event)
 
                 case STATE_EDIT:
                     sm->current_state = STATE_MENU;
+                    button_set_repeat_mask(0);
                     break;
 
                 default:
@@ -70,6 +207,15 @@ void state_machine_process_button(state_machine_t* sm, button_event_t btn_event)
             }
             break;
 
+        case BUTTON_EVENT_REPEAT:
+            // Held button: keeps stepping its way, at the accelerating rate
+            if (sm->current_state == STATE_EDIT && direction != 0) {
+                edit_step(sm, direction > 0);
+            } else {
+                sm->display_update_needed = false;
+            }
+            break;
+
         default:
             break;
     }
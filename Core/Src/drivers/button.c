@@ -2,216 +2,548 @@
   ******************************************************************************
   * @file    button.c
   * @brief   Push button driver implementation.
+  * @note    All buttons on PA0-PA3 are sampled with one GPIOA->IDR read and
+  *          debounced in parallel with a 2-bit vertical counter: one bit
+  *          plane per counter bit, one bit lane per button. Press/release,
+  *          long press and double-click are then derived from bitmasks, so
+  *          the per-sample cost does not grow with the number of buttons.
+  * @note    Everything runs in interrupt context: an EXTI edge arms a
+  *          one-shot TIM7 that samples every BUTTON_SAMPLE_MS until the lines
+  *          settle, then re-arms once for the double-click deadline if one
+  *          is open. With no button activity no code runs at all.
+  *          Held repeat-enabled buttons keep one deadline armed for their
+  *          next BUTTON_EVENT_REPEAT.
+  * @note    With BUTTON_USE_INPUT_CAPTURE the lines are TIM5 capture inputs:
+  *          the first edge of each burst is latched in hardware at 1 us and
+  *          the classifier measures durations from those timestamps, so
+  *          interrupt latency does not skew press or click timing.
   ******************************************************************************
   */
 
 /* Includes ------------------------------------------------------------------*/
 #include "button.h"
+#include "button_debounce.h"
 #include "board_config.h"
 #include "systick.h"
+#include "clock.h"
 #include "stm32f4xx.h"
+#include <stddef.h>
+
+/* Private define ------------------------------------------------------------*/
+
+/* Internal time base: TIM5 counts in us, otherwise systick in ms */
+#if BUTTON_USE_INPUT_CAPTURE
+#define BUTTON_TICKS_PER_MS     1000U
+#define BUTTON_CAPTURE_FLAGS    (TIM_SR_CC1IF | TIM_SR_CC2IF | TIM_SR_CC3IF | TIM_SR_CC4IF | \
+                                 TIM_SR_CC1OF | TIM_SR_CC2OF | TIM_SR_CC3OF | TIM_SR_CC4OF)
+#else
+#define BUTTON_TICKS_PER_MS     1U
+#endif
+
+#define BUTTON_MS(ms)           ((uint32_t)(ms) * BUTTON_TICKS_PER_MS)
+
+/* Debounce timer: 10 kHz keeps PSC within 16 bits for any timer clock
+   up to 655 MHz; the 16-bit ARR then spans up to 6.5 s per arm */
+#define BUTTON_TIMER_TICK_HZ    10000U
+#define BUTTON_TIMER_TICKS_MS   (BUTTON_TIMER_TICK_HZ / 1000U)
+#define BUTTON_TIMER_MAX_MS     (0x10000U / BUTTON_TIMER_TICKS_MS)
 
 /* Private typedef -----------------------------------------------------------*/
 
 /**
-  * @brief  Button state machine states.
+  * @brief  Lock-free single-producer / single-consumer event FIFO.
+  * @note   head is only written by the producer, tail only by the
+  *         consumer; both run free over uint8_t and are masked on use.
   */
-typedef enum {
-    BTN_STATE_IDLE = 0,
-    BTN_STATE_DEBOUNCING,
-    BTN_STATE_PRESSED,
-    BTN_STATE_LONG_PRESS
-} button_state_t;
+typedef struct {
+    button_event_info_t events[BUTTON_EVENT_QUEUE_SIZE];
+    volatile uint8_t head;                      /*!< Next slot to write */
+    volatile uint8_t tail;                      /*!< Next slot to read */
+    button_queue_stats_t stats;
+} button_queue_t;
 
 /**
   * @brief  Button control structure.
   */
 typedef struct {
-    button_state_t state;           /*!< Current state */
-    uint32_t state_enter_time;      /*!< When we entered current state */
-    uint32_t press_start_time;      /*!< When button was first pressed */
-    button_event_t pending_event;   /*!< Event to return */
-    uint8_t click_count;            /*!< Click counter for double-click */
-    uint32_t last_release_time;     /*!< Time of last release */
+    button_debounce_t db;                       /*!< Parallel debouncer */
+    uint8_t click_pending;                      /*!< One short click waiting for a second */
+    bool sampling;                              /*!< Timer armed at the sample period */
+    uint8_t repeat_mask;                        /*!< Buttons that auto-repeat when held */
+    uint8_t repeating;                          /*!< Held buttons that already repeated */
+    uint32_t next_repeat_time[BUTTON_COUNT];    /*!< Deadline of the next repeat */
+    uint16_t repeat_interval[BUTTON_COUNT];     /*!< Current (accelerating) interval */
+    uint8_t edge_latched;                       /*!< Buttons with a captured edge pending */
+    uint32_t edge_time[BUTTON_COUNT];           /*!< First captured edge of the burst */
+    uint32_t press_start_time[BUTTON_COUNT];    /*!< When each button was pressed */
+    uint32_t last_release_time[BUTTON_COUNT];   /*!< Time of each last release */
 } button_ctrl_t;
 
 /* Private variables ---------------------------------------------------------*/
-static button_ctrl_t btn = {0};
+/* Repeat mask survives button_init(): it may be chosen before the driver starts */
+static button_ctrl_t btn = { .repeat_mask = BUTTON_REPEAT_MASK_DEFAULT };
+static button_queue_t queue = {0};
+
+_Static_assert((BUTTON_EVENT_QUEUE_SIZE & (BUTTON_EVENT_QUEUE_SIZE - 1)) == 0,
+               "BUTTON_EVENT_QUEUE_SIZE must be a power of two");
 
 /* Private function prototypes -----------------------------------------------*/
-static void process_idle_state(void);
-static void process_debouncing_state(void);
-static void process_pressed_state(void);
-static void process_long_press_state(void);
+static uint8_t button_sample(void);
+static void button_classify(uint8_t toggled, uint32_t now);
+static void button_repeat(uint32_t now);
+static void button_push_event(button_id_t id, button_event_t event);
+static uint32_t button_now(void);
+static uint32_t button_edge_time(uint8_t i, uint32_t now);
+static void button_wake(void);
+static void button_capture_init(void);
+static void button_timer_init(void);
+static void button_timer_arm(uint32_t delay_ms);
+static void button_schedule(uint32_t now);
 
 /* Exported functions --------------------------------------------------------*/
 
 void button_init(void) {
     /* 1. Enable GPIOA clock */
-    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;
-
-    /* 2. Configure PA0 as input with pull-up */
-    GPIOA->MODER &= ~GPIO_MODER_MODER0;     /* Input mode */
-    GPIOA->PUPDR &= ~GPIO_PUPDR_PUPDR0;     /* Clear pull settings */
+    BUTTON_GPIO_CLK_ENABLE();
+
+    /* 2. Configure PA0-PA3 as inputs (PA0 has an external pull-down on
+          the Discovery board, PA1-PA3 use the internal one). In capture
+          mode they are TIM5 inputs; IDR still reads the pin levels. */
+    for (uint32_t pin = 0; pin < BUTTON_PIN_COUNT; pin++) {
+        BUTTON_GPIO_PORT->MODER &= ~(3U << (pin * 2));   /* Input mode */
+#if BUTTON_USE_INPUT_CAPTURE
+        BUTTON_GPIO_PORT->MODER |= (2U << (pin * 2));    /* Alternate function */
+        BUTTON_GPIO_PORT->AFR[0] &= ~(0xFU << (pin * 4));
+        BUTTON_GPIO_PORT->AFR[0] |= ((uint32_t)BUTTON_CAPTURE_AF << (pin * 4));
+#endif
+        BUTTON_GPIO_PORT->PUPDR &= ~(3U << (pin * 2));   /* Clear pull settings */
+        if (pin != 0) {
+            BUTTON_GPIO_PORT->PUPDR |= (2U << (pin * 2)); /* Pull-down */
+        }
+    }
 
+#if BUTTON_USE_INPUT_CAPTURE
+    /* 3-6. Capture interrupts wake the sampler instead of EXTI */
+    button_capture_init();
+#else
 
     /* 3. Enable SYSCFG clock for EXTI */
     RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
 
-    /* 4. Connect PA0 to EXTI0 */
-    SYSCFG->EXTICR[0] &= ~SYSCFG_EXTICR1_EXTI0;
-    SYSCFG->EXTICR[0] |= SYSCFG_EXTICR1_EXTI0_PA;
+    /* 4. Connect PA0-PA3 to EXTI0-EXTI3 (EXTICR1 = 0x0000 selects port A) */
+    SYSCFG->EXTICR[0] &= ~0xFFFFU;
 
-    /* 5. Configure EXTI line 0 */
-    EXTI->IMR |= EXTI_IMR_MR0;      /* Unmask EXTI0 */
-    EXTI->FTSR |= EXTI_FTSR_TR0;    /* Falling edge trigger (release) */
-    EXTI->RTSR |= EXTI_RTSR_TR0;    /* Rising edge trigger (press) */
+    /* 5. Configure EXTI lines 0-3 on both edges - they only wake the sampler */
+    EXTI->IMR |= BUTTON_ALL_PINS;
+    EXTI->FTSR |= BUTTON_ALL_PINS;
+    EXTI->RTSR |= BUTTON_ALL_PINS;
+    EXTI->PR = BUTTON_ALL_PINS;
 
-    /* 6. Enable EXTI0 interrupt in NVIC */
-    NVIC_SetPriority(EXTI0_IRQn, 0);
+    /* 6. Enable EXTI0-EXTI3 interrupts in NVIC */
+    NVIC_SetPriority(EXTI0_IRQn, EXTI_PRIORITY);
+    NVIC_SetPriority(EXTI1_IRQn, EXTI_PRIORITY);
+    NVIC_SetPriority(EXTI2_IRQn, EXTI_PRIORITY);
+    NVIC_SetPriority(EXTI3_IRQn, EXTI_PRIORITY);
     NVIC_EnableIRQ(EXTI0_IRQn);
+    NVIC_EnableIRQ(EXTI1_IRQn);
+    NVIC_EnableIRQ(EXTI2_IRQn);
+    NVIC_EnableIRQ(EXTI3_IRQn);
+#endif
+
+    /* 7. Initialize control structure from the current pin levels */
+    button_debounce_init(&btn.db, button_sample());
+    btn.click_pending = 0;
+    btn.sampling = false;
+    btn.repeating = 0;
+    btn.edge_latched = 0;
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        btn.press_start_time[i] = button_now();
+        btn.last_release_time[i] = 0;
+    }
+
+    queue.head = 0;
+    queue.tail = 0;
 
-    /* 7. Initialize control structure */
-    btn.state = BTN_STATE_IDLE;
-    btn.state_enter_time = systick_get_ticks();
-    btn.pending_event = BUTTON_EVENT_NONE;
-    btn.click_count = 0;
-    btn.last_release_time = 0;
+    /* 8. One-shot debounce timer */
+    button_timer_init();
 }
 
 bool button_is_pressed_raw(void) {
     /* Active-high button: 1 = pressed, 0 = released */
-    return (GPIOA->IDR & GPIO_IDR_ID0) != 0;
+    return (button_sample() & (1U << BUTTON_HOUR)) != 0;
 }
 
 bool button_is_pressed(void) {
-    return (btn.state == BTN_STATE_PRESSED || btn.state == BTN_STATE_LONG_PRESS);
+    return button_is_down(BUTTON_HOUR);
+}
+
+bool button_is_down(button_id_t id) {
+    return (id < BUTTON_COUNT) && (btn.db.state & (1U << id)) != 0;
+}
+
+uint8_t button_get_pressed_mask(void) {
+    return btn.db.state;
+}
+
+void button_set_repeat_mask(uint8_t mask) {
+    /* Single byte store: the timer ISR sees the old or the new mask */
+    btn.repeat_mask = mask & (uint8_t)((1U << BUTTON_COUNT) - 1U);
+}
+
+uint8_t button_get_repeat_mask(void) {
+    return btn.repeat_mask;
 }
 
 button_event_t button_get_event(void) {
-    button_event_t event = btn.pending_event;
-    btn.pending_event = BUTTON_EVENT_NONE;
-    return event;
+    button_event_info_t info;
+    uint8_t tail = queue.tail;
+
+    /* Single-button API: reports a HOUR event at the head of the queue.
+       Any other event stays queued for button_poll_event(). */
+    if (tail == queue.head ||
+        queue.events[tail & (BUTTON_EVENT_QUEUE_SIZE - 1)].id != BUTTON_HOUR) {
+        return BUTTON_EVENT_NONE;
+    }
+
+    button_poll_event(&info);
+    return info.event;
 }
 
-void button_update(void) {
-    uint32_t current_time = systick_get_ticks();
+bool button_event_pending(void) {
+    return queue.tail != queue.head;
+}
+
+bool button_poll_event(button_event_info_t* info) {
+    uint8_t tail = queue.tail;
+
+    if (info == NULL || tail == queue.head) {
+        return false;
+    }
 
-    switch (btn.state) {
-        case BTN_STATE_IDLE:
-            process_idle_state();
-            break;
+    *info = queue.events[tail & (BUTTON_EVENT_QUEUE_SIZE - 1)];
 
-        case BTN_STATE_DEBOUNCING:
-            process_debouncing_state();
-            break;
+    /* Slot fully read before handing it back to the producer */
+    __DMB();
+    queue.tail = tail + 1;
 
-        case BTN_STATE_PRESSED:
-            process_pressed_state();
-            break;
+    uint32_t latency = systick_get_ticks() - info->timestamp_ms;
+    queue.stats.last_latency_ms = latency;
+    if (latency > queue.stats.max_latency_ms) {
+        queue.stats.max_latency_ms = latency;
+    }
+
+    return true;
+}
 
-        case BTN_STATE_LONG_PRESS:
-            process_long_press_state();
-            break;
+void button_get_queue_stats(button_queue_stats_t* stats) {
+    if (stats != NULL) {
+        *stats = queue.stats;
     }
 }
 
 void button_exti_handler(void) {
-    /* Check if EXTI0 triggered */
-    if (EXTI->PR & EXTI_PR_PR0) {
-        /* Clear pending bit */
-        EXTI->PR = EXTI_PR_PR0;
-
-        /* Update button state based on interrupt */
-        bool pressed = button_is_pressed_raw();
-
-        if (pressed && btn.state == BTN_STATE_IDLE) {
-            /* Press detected - start de-bouncing */
-            btn.state = BTN_STATE_DEBOUNCING;
-            btn.state_enter_time = systick_get_ticks();
-        }
-        else if (!pressed && (btn.state == BTN_STATE_PRESSED ||
-                              btn.state == BTN_STATE_LONG_PRESS)) {
-            /* Release detected - start de-bouncing */
-            btn.state = BTN_STATE_DEBOUNCING;
-            btn.state_enter_time = systick_get_ticks();
+    /* Check if any button EXTI line triggered */
+    uint32_t pending = EXTI->PR & BUTTON_ALL_PINS;
+
+    if (pending) {
+        /* Clear pending bits */
+        EXTI->PR = pending;
+
+        button_wake();
+    }
+}
+
+void button_capture_irq_handler(void) {
+#if BUTTON_USE_INPUT_CAPTURE
+    uint32_t sr = BUTTON_CAPTURE_TIMER->SR & BUTTON_CAPTURE_FLAGS;
+    BUTTON_CAPTURE_TIMER->SR = ~sr;
+
+    if (sr == 0) {
+        return;
+    }
+
+    /* Keep only the first edge of each burst: that is the real press or
+       release, later captures are contact bounce */
+    volatile uint32_t* ccr = &BUTTON_CAPTURE_TIMER->CCR1;
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        uint8_t bit = (uint8_t)(1U << i);
+
+        if ((sr & (TIM_SR_CC1IF << i)) && !(btn.edge_latched & bit)) {
+            btn.edge_time[i] = ccr[i];
+            btn.edge_latched |= bit;
         }
     }
+
+    button_wake();
+#endif
+}
+
+void button_timer_irq_handler(void) {
+    if ((BUTTON_TIMER->SR & TIM_SR_UIF) == 0) {
+        return;
+    }
+    BUTTON_TIMER->SR = ~TIM_SR_UIF;
+
+    uint32_t now = button_now();
+
+    /* One IDR read debounces every button */
+    uint8_t toggled = button_debounce_step(&btn.db, button_sample());
+    button_classify(toggled, now);
+    button_repeat(now);
+
+    button_schedule(now);
 }
 
 /* Private functions ---------------------------------------------------------*/
 
-static void process_idle_state(void) {
-    /* Nothing to do in idle state */
+/**
+  * @brief  Current time in the classifier's time base.
+  */
+static uint32_t button_now(void) {
+#if BUTTON_USE_INPUT_CAPTURE
+    return BUTTON_CAPTURE_TIMER->CNT;
+#else
+    return systick_get_ticks();
+#endif
+}
 
-    /* Check for double-click timeout */
-    uint32_t current_time = systick_get_ticks();
-    if (btn.click_count > 0 && (current_time - btn.last_release_time) > DOUBLE_CLICK_MAX_MS) {
-        /* Timeout - generate single click event */
-        if (btn.click_count == 1) {
-            btn.pending_event = BUTTON_EVENT_SHORT_PRESS;
-        }
-        btn.click_count = 0;
+/**
+  * @brief  Time of the edge behind a debounced transition.
+  * @param  i: Button index
+  * @param  now: Sample time, used when no edge was captured
+  */
+static uint32_t button_edge_time(uint8_t i, uint32_t now) {
+    uint8_t bit = (uint8_t)(1U << i);
+
+    if (btn.edge_latched & bit) {
+        btn.edge_latched &= (uint8_t)~bit;
+        return btn.edge_time[i];
     }
+    return now;
 }
 
-static void process_debouncing_state(void) {
-    uint32_t current_time = systick_get_ticks();
+/**
+  * @brief  Start sampling; bounces while sampling need nothing more.
+  */
+static void button_wake(void) {
+    if (!btn.sampling) {
+        btn.sampling = true;
+        button_timer_arm(BUTTON_SAMPLE_MS);
+    }
+}
 
-    /* Wait for de-bounce time to pass */
-    if (current_time - btn.state_enter_time >= DEBOUNCE_TIME_MS) {
-        bool pressed = button_is_pressed_raw();
+/**
+  * @brief  Configure TIM5 CH1-CH4 to capture both edges at 1 MHz.
+  */
+static void button_capture_init(void) {
+#if BUTTON_USE_INPUT_CAPTURE
+    BUTTON_CAPTURE_CLK_ENABLE();
+
+    BUTTON_CAPTURE_TIMER->CR1 = 0;
+    BUTTON_CAPTURE_TIMER->PSC = (clock_apb1_timer_hz() / 1000000U) - 1U; /* 1 us */
+    BUTTON_CAPTURE_TIMER->ARR = 0xFFFFFFFFU;                       /* Full 32 bits */
+
+    /* CCxS = 01: ICx mapped on TIx, no prescaler, no filter */
+    BUTTON_CAPTURE_TIMER->CCMR1 = TIM_CCMR1_CC1S_0 | TIM_CCMR1_CC2S_0;
+    BUTTON_CAPTURE_TIMER->CCMR2 = TIM_CCMR2_CC3S_0 | TIM_CCMR2_CC4S_0;
+
+    /* CCxP = CCxNP = 1: both edges */
+    BUTTON_CAPTURE_TIMER->CCER = TIM_CCER_CC1E | TIM_CCER_CC1P | TIM_CCER_CC1NP |
+                                 TIM_CCER_CC2E | TIM_CCER_CC2P | TIM_CCER_CC2NP |
+                                 TIM_CCER_CC3E | TIM_CCER_CC3P | TIM_CCER_CC3NP |
+                                 TIM_CCER_CC4E | TIM_CCER_CC4P | TIM_CCER_CC4NP;
+
+    BUTTON_CAPTURE_TIMER->EGR = TIM_EGR_UG;
+    BUTTON_CAPTURE_TIMER->SR = 0;
+    BUTTON_CAPTURE_TIMER->DIER = TIM_DIER_CC1IE | TIM_DIER_CC2IE |
+                                 TIM_DIER_CC3IE | TIM_DIER_CC4IE;
+    BUTTON_CAPTURE_TIMER->CR1 = TIM_CR1_CEN;
+
+    NVIC_SetPriority(BUTTON_CAPTURE_IRQN, EXTI_PRIORITY);
+    NVIC_EnableIRQ(BUTTON_CAPTURE_IRQN);
+#endif
+}
 
-        if (pressed) {
-            /* Press is stable - enter PRESSED state */
-            btn.state = BTN_STATE_PRESSED;
-            btn.press_start_time = current_time;
-        } else {
-            /* Release is stable - generate event and go to IDLE */
-            btn.state = BTN_STATE_IDLE;
-            btn.last_release_time = current_time;
-
-            /* Determine what type of release this was */
-            if ((current_time - btn.press_start_time) >= LONG_PRESS_TIME_MS) {
-                /* Long press release */
-                btn.pending_event = BUTTON_EVENT_LONG_PRESS;
-                btn.click_count = 0;  // Long press cancels any pending clicks
-            } else {
-                /* Short press - count clicks */
-                btn.click_count++;
-
-                /* Check if this is a double-click */
-                if (btn.click_count == 2) {
-                    btn.pending_event = BUTTON_EVENT_DOUBLE_CLICK;
-                    btn.click_count = 0;
-                }
-                /* Single click will be generated after timeout in idle state */
-            }
-        }
+/**
+  * @brief  Configure the debounce timer for one-shot delays in ms.
+  */
+static void button_timer_init(void) {
+    uint32_t psc = clock_apb1_timer_hz() / BUTTON_TIMER_TICK_HZ - 1U;
+
+    BUTTON_TIMER_CLK_ENABLE();
+
+    BUTTON_TIMER->CR1 = TIM_CR1_OPM | TIM_CR1_URS;          /* One-shot, UIF on overflow only */
+    BUTTON_TIMER->PSC = (psc > 0xFFFFU) ? 0xFFFFU : psc;    /* 10 kHz count */
+    BUTTON_TIMER->EGR = TIM_EGR_UG;                         /* Load prescaler */
+    BUTTON_TIMER->SR = 0;
+    BUTTON_TIMER->DIER = TIM_DIER_UIE;
+
+    NVIC_SetPriority(BUTTON_TIMER_IRQN, BUTTON_TIMER_PRIORITY);
+    NVIC_EnableIRQ(BUTTON_TIMER_IRQN);
+}
+
+/**
+  * @brief  (Re)start the one-shot timer.
+  * @param  delay_ms: Delay until the timer interrupt (1-6553 ms); a longer
+  *         deadline wakes early and is re-armed by button_schedule()
+  */
+static void button_timer_arm(uint32_t delay_ms) {
+    if (delay_ms < 1) delay_ms = 1;
+    if (delay_ms > BUTTON_TIMER_MAX_MS) delay_ms = BUTTON_TIMER_MAX_MS;
+
+    BUTTON_TIMER->CR1 &= ~TIM_CR1_CEN;
+    BUTTON_TIMER->CNT = 0;
+    BUTTON_TIMER->ARR = delay_ms * BUTTON_TIMER_TICKS_MS - 1U;
+    BUTTON_TIMER->CR1 |= TIM_CR1_CEN;
+}
+
+/**
+  * @brief  Pick the next timer deadline, or go idle.
+  * @param  now: Current time
+  */
+static void button_schedule(uint32_t now) {
+    /* Lines still disagree with the debounced state - keep sampling */
+    if ((btn.db.cnt0 | btn.db.cnt1) != 0 || button_sample() != btn.db.state) {
+        btn.sampling = true;
+        button_timer_arm(BUTTON_SAMPLE_MS);
+        return;
+    }
+
+    btn.sampling = false;
+    btn.edge_latched = 0;       /* Glitches that never debounced */
+
+    /* Settled: wake for the earliest repeat or double-click deadline */
+    uint32_t next = UINT32_MAX;
+    for (uint8_t mask = btn.db.state & btn.repeat_mask; mask != 0; mask &= mask - 1) {
+        uint8_t i = (uint8_t)__builtin_ctz(mask);
+        uint32_t left = (int32_t)(btn.next_repeat_time[i] - now) > 0 ?
+                        (btn.next_repeat_time[i] - now) : 0;
+
+        if (left < next) next = left;
+    }
+    for (uint8_t mask = btn.click_pending; mask != 0; mask &= mask - 1) {
+        uint8_t i = (uint8_t)__builtin_ctz(mask);
+        uint32_t expires = btn.last_release_time[i] + BUTTON_MS(DOUBLE_CLICK_MAX_MS) + 1U;
+        uint32_t left = (int32_t)(expires - now) > 0 ? (expires - now) : 0;
+
+        if (left < next) next = left;
+    }
+
+    if (next != UINT32_MAX) {
+        button_timer_arm((next + BUTTON_TICKS_PER_MS - 1U) / BUTTON_TICKS_PER_MS);
+    } else {
+        BUTTON_TIMER->CR1 &= ~TIM_CR1_CEN;  /* Idle - nothing runs until the next edge */
     }
 }
 
-static void process_pressed_state(void) {
-    uint32_t current_time = systick_get_ticks();
-    uint32_t press_duration = current_time - btn.press_start_time;
+/**
+  * @brief  Read all button lines at once (bit i = button i, 1 = pressed).
+  */
+static uint8_t button_sample(void) {
+    return (uint8_t)(BUTTON_GPIO_PORT->IDR & BUTTON_ALL_PINS);
+}
 
-    /* Check for long press */
-    if (press_duration >= LONG_PRESS_TIME_MS) {
-        btn.state = BTN_STATE_LONG_PRESS;
+/**
+  * @brief  Queue an event for the consumer (producer side).
+  * @param  id: Button that produced the event
+  * @param  event: Event type
+  */
+static void button_push_event(button_id_t id, button_event_t event) {
+    uint8_t head = queue.head;
+
+    if ((uint8_t)(head - queue.tail) >= BUTTON_EVENT_QUEUE_SIZE) {
+        queue.stats.overflows++;    /* Full - drop the newest */
+        return;
     }
 
-    /* Check if button was released (via polling) */
-    if (!button_is_pressed_raw()) {
-        btn.state = BTN_STATE_DEBOUNCING;
-        btn.state_enter_time = current_time;
+    button_event_info_t* slot = &queue.events[head & (BUTTON_EVENT_QUEUE_SIZE - 1)];
+    slot->event = event;
+    slot->id = id;
+    slot->timestamp_ms = systick_get_ticks();
+
+    /* Publish only after the slot is written */
+    __DMB();
+    queue.head = head + 1;
+    queue.stats.queued++;
+}
+
+/**
+  * @brief  Derive click events from debounced edge masks.
+  * @param  toggled: Buttons whose debounced state changed this sample
+  * @param  now: Sample time
+  */
+static void button_classify(uint8_t toggled, uint32_t now) {
+    uint8_t pressed = toggled & btn.db.state;
+    uint8_t released = toggled & (uint8_t)~btn.db.state;
+    uint8_t mask;
+
+    /* Presses: remember when they started */
+    for (mask = pressed; mask != 0; mask &= mask - 1) {
+        uint8_t i = (uint8_t)__builtin_ctz(mask);
+        btn.press_start_time[i] = button_edge_time(i, now);
+        btn.next_repeat_time[i] = btn.press_start_time[i] + BUTTON_MS(BUTTON_REPEAT_DELAY_MS);
+        btn.repeat_interval[i] = BUTTON_REPEAT_START_MS;
+    }
+
+    /* Releases: long press, or first/second click */
+    for (mask = released; mask != 0; mask &= mask - 1) {
+        uint8_t i = (uint8_t)__builtin_ctz(mask);
+        uint8_t bit = (uint8_t)(1U << i);
+
+        btn.last_release_time[i] = button_edge_time(i, now);
+
+        if (btn.repeating & bit) {
+            /* Hold already delivered its repeats - release is silent */
+            btn.repeating &= (uint8_t)~bit;
+            btn.click_pending &= (uint8_t)~bit;
+        } else if ((btn.last_release_time[i] - btn.press_start_time[i]) >=
+                   BUTTON_MS(LONG_PRESS_TIME_MS)) {
+            /* Long press cancels any pending click */
+            button_push_event((button_id_t)i, BUTTON_EVENT_LONG_PRESS);
+            btn.click_pending &= (uint8_t)~bit;
+        } else if (btn.click_pending & bit) {
+            button_push_event((button_id_t)i, BUTTON_EVENT_DOUBLE_CLICK);
+            btn.click_pending &= (uint8_t)~bit;
+        } else {
+            /* Single click will be generated after timeout */
+            btn.click_pending |= bit;
+        }
+    }
+
+    /* Double-click window expired on released buttons - single click */
+    for (mask = btn.click_pending & (uint8_t)~btn.db.state; mask != 0; mask &= mask - 1) {
+        uint8_t i = (uint8_t)__builtin_ctz(mask);
+
+        if ((now - btn.last_release_time[i]) > BUTTON_MS(DOUBLE_CLICK_MAX_MS)) {
+            button_push_event((button_id_t)i, BUTTON_EVENT_SHORT_PRESS);
+            btn.click_pending &= (uint8_t)~(1U << i);
+        }
     }
 }
 
-static void process_long_press_state(void) {
-    /* Stay in long press until button is released */
-    if (!button_is_pressed_raw()) {
-        btn.state = BTN_STATE_DEBOUNCING;
-        btn.state_enter_time = systick_get_ticks();
+/**
+  * @brief  Emit repeat events for held repeat-enabled buttons.
+  * @param  now: Sample time
+  * @note   Interval shrinks by BUTTON_REPEAT_ACCEL_MS per repeat down to
+  *         BUTTON_REPEAT_MIN_MS. A late wakeup produces one event, not a burst.
+  */
+static void button_repeat(uint32_t now) {
+    for (uint8_t mask = btn.db.state & btn.repeat_mask; mask != 0; mask &= mask - 1) {
+        uint8_t i = (uint8_t)__builtin_ctz(mask);
+
+        if ((int32_t)(now - btn.next_repeat_time[i]) < 0) {
+            continue;
+        }
+
+        button_push_event((button_id_t)i, BUTTON_EVENT_REPEAT);
+        btn.repeating |= (uint8_t)(1U << i);
+
+        btn.next_repeat_time[i] = now + BUTTON_MS(btn.repeat_interval[i]);
+        if (btn.repeat_interval[i] > BUTTON_REPEAT_MIN_MS + BUTTON_REPEAT_ACCEL_MS) {
+            btn.repeat_interval[i] -= BUTTON_REPEAT_ACCEL_MS;
+        } else {
+            btn.repeat_interval[i] = BUTTON_REPEAT_MIN_MS;
+        }
     }
 }
 
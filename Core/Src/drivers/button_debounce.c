@@ -0,0 +1,37 @@
+/**
+  ******************************************************************************
+  * @file    button_debounce.c
+  * @brief   Parallel vertical-counter debouncer.
+  * @note    Each lane has a 2-bit counter spread over two bit planes. A
+  *          sample that differs from the debounced state advances the lane's
+  *          counter, one that agrees clears it; the lane toggles when the
+  *          counter wraps after BUTTON_DEBOUNCE_SAMPLES differing samples.
+  *          All lanes advance with a handful of bitwise operations, so the
+  *          cost does not grow with the number of buttons.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "button_debounce.h"
+
+/* Exported functions --------------------------------------------------------*/
+
+void button_debounce_init(button_debounce_t* db, uint8_t levels) {
+    db->state = levels;
+    db->cnt0 = 0;
+    db->cnt1 = 0;
+}
+
+uint8_t button_debounce_step(button_debounce_t* db, uint8_t sample) {
+    uint8_t delta = sample ^ db->state;
+
+    db->cnt1 = (db->cnt1 ^ db->cnt0) & delta;
+    db->cnt0 = (uint8_t)~db->cnt0 & delta;
+
+    uint8_t toggled = delta & (uint8_t)~(db->cnt0 | db->cnt1);
+    db->state ^= toggled;
+
+    return toggled;
+}
+
+/******************************** END OF FILE *********************************/
@@ -102,3 +102,106 @@ const uint8_t settings_char[8] = {
     0b01110,    /*  ***  */
     0b00000     /*       */
 };
+
+/* Big digit: upper-left corner */
+const uint8_t big_lt_char[8] = {
+    0b00111,    /*   *** */
+    0b01111,    /*  **** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111     /* ***** */
+};
+
+/* Big digit: upper bar */
+const uint8_t big_ub_char[8] = {
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b00000,    /*       */
+    0b00000,    /*       */
+    0b00000,    /*       */
+    0b00000,    /*       */
+    0b00000     /*       */
+};
+
+/* Big digit: upper-right corner */
+const uint8_t big_rt_char[8] = {
+    0b11100,    /* ***   */
+    0b11110,    /* ****  */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111     /* ***** */
+};
+
+/* Big digit: lower-left corner */
+const uint8_t big_ll_char[8] = {
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b01111,    /*  **** */
+    0b00111     /*   *** */
+};
+
+/* Big digit: lower bar */
+const uint8_t big_lb_char[8] = {
+    0b00000,    /*       */
+    0b00000,    /*       */
+    0b00000,    /*       */
+    0b00000,    /*       */
+    0b00000,    /*       */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111     /* ***** */
+};
+
+/* Big digit: lower-right corner */
+const uint8_t big_lr_char[8] = {
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11110,    /* ****  */
+    0b11100     /* ***   */
+};
+
+/* Big digit: upper + middle bars */
+const uint8_t big_umb_char[8] = {
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b11111,    /* ***** */
+    0b00000,    /*       */
+    0b00000,    /*       */
+    0b00000,    /*       */
+    0b11111,    /* ***** */
+    0b11111     /* ***** */
+};
+
+/* Glyph ID -> bitmap */
+const uint8_t* const glyph_bitmaps[GLYPH_COUNT] = {
+    [GLYPH_BELL]      = bell_char,
+    [GLYPH_ALARM_ON]  = alarm_on_char,
+    [GLYPH_ALARM_OFF] = alarm_off_char,
+    [GLYPH_CHECK]     = check_char,
+    [GLYPH_CROSS]     = cross_char,
+    [GLYPH_CLOCK]     = clock_char,
+    [GLYPH_CALENDAR]  = calendar_char,
+    [GLYPH_SETTINGS]  = settings_char,
+    [GLYPH_BIG_LT]    = big_lt_char,
+    [GLYPH_BIG_UB]    = big_ub_char,
+    [GLYPH_BIG_RT]    = big_rt_char,
+    [GLYPH_BIG_LL]    = big_ll_char,
+    [GLYPH_BIG_LB]    = big_lb_char,
+    [GLYPH_BIG_LR]    = big_lr_char,
+    [GLYPH_BIG_UMB]   = big_umb_char,
+};
@@ -0,0 +1,316 @@
+/**
+  ******************************************************************************
+  * @file    display_backend.c
+  * @brief   Emulated character grid for the non-HD44780 backends.
+  * @note    The renderer is written against HD44780 DDRAM: 2 x 40 cells,
+  *          a 16-column window moved by the display offset. This file keeps
+  *          that grid in RAM and draws the cells inside the window:
+  *          - SSD1306: 6x8 cells into the framebuffer, centred on the panel;
+  *            the framebuffer diff sends only bytes that changed, so a page
+  *            flip costs the cells that differ, not the whole window.
+  *          - Host terminal: the window is printed to stdout when it changed,
+  *            and bytes are counted as the PCF8574 would have sent them, so
+  *            frame budgets and stats match the LCD.
+  *          The LCD backend is inline in display_backend.h.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "display_backend.h"
+
+#if DISPLAY_TYPE != DISPLAY_LCD_1602
+
+#include <string.h>
+#if DISPLAY_TYPE == DISPLAY_OLED_SSD1306
+#include "ssd1306.h"
+#include "i2c.h"
+#else
+#include <stdio.h>
+#endif
+
+/* Private define ------------------------------------------------------------*/
+#define ROM_FULL_BLOCK      ((char)0xFF)    /* HD44780 ROM characters the */
+#define ROM_MIDDLE_DOT      ((char)0xA5)    /* layouts use */
+
+#if DISPLAY_TYPE == DISPLAY_OLED_SSD1306
+/* Window placement on the panel */
+#define GRID_X0             ((SSD1306_WIDTH - DISPLAY_BACKEND_VISIBLE_COLS * SSD1306_FONT_PITCH) / 2)
+#define GRID_PAGE0          ((SSD1306_PAGES - DISPLAY_BACKEND_ROWS) / 2)
+#else
+#define LCD_BYTE_COST       4               /* PCF8574 bytes per HD44780 byte */
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+static char grid_text[DISPLAY_BACKEND_ROWS][DISPLAY_BACKEND_COLS];
+static uint8_t grid_glyph[DISPLAY_BACKEND_ROWS][DISPLAY_BACKEND_COLS];
+static uint8_t grid_offset = 0;
+static bool backend_ready = false;
+
+#if DISPLAY_TYPE == DISPLAY_HOST_TERMINAL
+static bool window_changed = false;
+static uint32_t byte_count = 0;
+
+/* Stand-ins for the custom characters */
+static const char glyph_symbol[GLYPH_COUNT] = {
+    [GLYPH_BELL]      = '^',
+    [GLYPH_ALARM_ON]  = '@',
+    [GLYPH_ALARM_OFF] = 'o',
+    [GLYPH_CHECK]     = 'v',
+    [GLYPH_CROSS]     = 'x',
+    [GLYPH_CLOCK]     = 'c',
+    [GLYPH_CALENDAR]  = '=',
+    [GLYPH_SETTINGS]  = '*',
+    [GLYPH_BIG_LT]    = '#',
+    [GLYPH_BIG_UB]    = '#',
+    [GLYPH_BIG_RT]    = '#',
+    [GLYPH_BIG_LL]    = '#',
+    [GLYPH_BIG_LB]    = '#',
+    [GLYPH_BIG_LR]    = '#',
+    [GLYPH_BIG_UMB]   = '#',
+};
+#endif
+
+/* Private function prototypes -----------------------------------------------*/
+static void grid_reset(void);
+static void grid_cell_changed(uint8_t row, uint8_t col);
+static void grid_redraw_window(void);
+static void cell_draw(uint8_t row, uint8_t window_col);
+
+/* Exported functions --------------------------------------------------------*/
+
+void display_backend_init_start(bool warm) {
+    /* Neither backend keeps state worth reusing across a reset */
+    (void)warm;
+    backend_ready = false;
+}
+
+bool display_backend_init_poll(void) {
+    if (backend_ready) {
+        return true;
+    }
+
+#if DISPLAY_TYPE == DISPLAY_OLED_SSD1306
+    if (!ssd1306_init()) {
+        return false;       /* Panel not answering: retried on the next poll */
+    }
+#else
+    fputs("\033[2J", stdout);
+#endif
+
+    grid_reset();
+    backend_ready = true;
+    return true;
+}
+
+bool display_backend_ready(void) {
+    return backend_ready;
+}
+
+void display_backend_power_on(void) {
+    /* SSD1306 init ends with display on; a terminal has no backlight */
+}
+
+void display_backend_clear(void) {
+#if DISPLAY_TYPE == DISPLAY_HOST_TERMINAL
+    byte_count += LCD_BYTE_COST;
+#endif
+    grid_reset();
+}
+
+void display_backend_set_cursor(uint8_t row, uint8_t col) {
+    /* Writes carry their cell; only the LCD byte cost is modelled */
+    (void)row;
+    (void)col;
+#if DISPLAY_TYPE == DISPLAY_HOST_TERMINAL
+    byte_count += LCD_BYTE_COST;
+#endif
+}
+
+void display_backend_write_char(uint8_t row, uint8_t col, char c) {
+    if (row >= DISPLAY_BACKEND_ROWS || col >= DISPLAY_BACKEND_COLS) return;
+
+#if DISPLAY_TYPE == DISPLAY_HOST_TERMINAL
+    byte_count += LCD_BYTE_COST;
+#endif
+
+    if (grid_text[row][col] != c || grid_glyph[row][col] != GLYPH_NONE) {
+        grid_text[row][col] = c;
+        grid_glyph[row][col] = GLYPH_NONE;
+        grid_cell_changed(row, col);
+    }
+}
+
+bool display_backend_put_glyph(uint8_t row, uint8_t col, glyph_id_t glyph) {
+    if (row >= DISPLAY_BACKEND_ROWS || col >= DISPLAY_BACKEND_COLS || glyph >= GLYPH_COUNT) {
+        return false;
+    }
+
+#if DISPLAY_TYPE == DISPLAY_HOST_TERMINAL
+    byte_count += 2 * LCD_BYTE_COST;    /* Cursor + slot index */
+#endif
+
+    if (grid_glyph[row][col] != glyph) {
+        grid_text[row][col] = ' ';
+        grid_glyph[row][col] = glyph;
+        grid_cell_changed(row, col);
+    }
+    return true;
+}
+
+void display_backend_set_offset(uint8_t offset) {
+    if (offset >= DISPLAY_BACKEND_COLS || offset == grid_offset) return;
+
+#if DISPLAY_TYPE == DISPLAY_HOST_TERMINAL
+    /* Shortest shift direction, or return home for 0 (as the LCD does) */
+    uint8_t left = (uint8_t)((offset + DISPLAY_BACKEND_COLS - grid_offset) % DISPLAY_BACKEND_COLS);
+    uint8_t right = (uint8_t)(DISPLAY_BACKEND_COLS - left);
+    uint8_t shifts = (offset == 0) ? 1 : ((left <= right) ? left : right);
+    byte_count += shifts * LCD_BYTE_COST;
+#endif
+
+    grid_offset = offset;
+    grid_redraw_window();
+}
+
+uint8_t display_backend_get_offset(void) {
+    return grid_offset;
+}
+
+uint32_t display_backend_byte_count(void) {
+#if DISPLAY_TYPE == DISPLAY_OLED_SSD1306
+    ssd1306_stats_t stats;
+    ssd1306_get_stats(&stats);
+    return stats.i2c_bytes;
+#else
+    return byte_count;
+#endif
+}
+
+bool display_backend_poll(void) {
+#if DISPLAY_TYPE == DISPLAY_OLED_SSD1306
+    return ssd1306_flush_poll();
+#else
+    if (!window_changed) {
+        return false;
+    }
+
+    char line[DISPLAY_BACKEND_VISIBLE_COLS + 1];
+
+    fputs("\033[H+----------------+\n", stdout);
+    for (uint8_t row = 0; row < DISPLAY_BACKEND_ROWS; row++) {
+        for (uint8_t i = 0; i < DISPLAY_BACKEND_VISIBLE_COLS; i++) {
+            uint8_t col = (uint8_t)((grid_offset + i) % DISPLAY_BACKEND_COLS);
+            uint8_t glyph = grid_glyph[row][col];
+            char c = grid_text[row][col];
+
+            if (glyph != GLYPH_NONE) {
+                c = glyph_symbol[glyph];
+            } else if (c == ROM_FULL_BLOCK) {
+                c = '#';
+            } else if (c == ROM_MIDDLE_DOT) {
+                c = '.';
+            } else if (c < ' ' || c > '~') {
+                c = '?';
+            }
+            line[i] = c;
+        }
+        line[DISPLAY_BACKEND_VISIBLE_COLS] = '\0';
+        printf("|%s|\n", line);
+    }
+    fputs("+----------------+\n", stdout);
+    fflush(stdout);
+
+    window_changed = false;
+    return false;
+#endif
+}
+
+bool display_backend_pending(void) {
+#if DISPLAY_TYPE == DISPLAY_OLED_SSD1306
+    return ssd1306_is_dirty() && !i2c_dma_busy();
+#else
+    return window_changed;
+#endif
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Blank grid, window at column 0 (HD44780 clear).
+  */
+static void grid_reset(void) {
+    memset(grid_text, ' ', sizeof(grid_text));
+    memset(grid_glyph, GLYPH_NONE, sizeof(grid_glyph));
+    grid_offset = 0;
+    grid_redraw_window();
+}
+
+/**
+  * @brief  Draw a changed cell if the window shows it.
+  */
+static void grid_cell_changed(uint8_t row, uint8_t col) {
+    uint8_t window_col = (uint8_t)((col + DISPLAY_BACKEND_COLS - grid_offset) % DISPLAY_BACKEND_COLS);
+
+    if (window_col < DISPLAY_BACKEND_VISIBLE_COLS) {
+        cell_draw(row, window_col);
+    }
+}
+
+/**
+  * @brief  Draw every cell of the window (offset moved or grid reset).
+  */
+static void grid_redraw_window(void) {
+    for (uint8_t row = 0; row < DISPLAY_BACKEND_ROWS; row++) {
+        for (uint8_t i = 0; i < DISPLAY_BACKEND_VISIBLE_COLS; i++) {
+            cell_draw(row, i);
+        }
+    }
+}
+
+/**
+  * @brief  Put one window cell on the output.
+  * @param  row: Grid row
+  * @param  window_col: Column inside the visible window (0-15)
+  */
+static void cell_draw(uint8_t row, uint8_t window_col) {
+#if DISPLAY_TYPE == DISPLAY_OLED_SSD1306
+    uint8_t col = (uint8_t)((grid_offset + window_col) % DISPLAY_BACKEND_COLS);
+    uint8_t x = GRID_X0 + window_col * SSD1306_FONT_PITCH;
+    uint8_t page = GRID_PAGE0 + row;
+    uint8_t glyph = grid_glyph[row][col];
+    char c = grid_text[row][col];
+    uint8_t columns[SSD1306_FONT_W] = { 0 };
+
+    if (glyph != GLYPH_NONE) {
+        /* 5x8 CGRAM bitmap (row bytes, bit 4 = left) to column bytes */
+        const uint8_t* bitmap = glyph_bitmaps[glyph];
+
+        for (uint8_t i = 0; i < SSD1306_FONT_W; i++) {
+            for (uint8_t r = 0; r < 8; r++) {
+                if (bitmap[r] & (0x10U >> i)) {
+                    columns[i] |= (uint8_t)(1U << r);
+                }
+            }
+        }
+    } else if (c == ROM_FULL_BLOCK) {
+        memset(columns, 0xFF, sizeof(columns));
+    } else if (c == ROM_MIDDLE_DOT) {
+        columns[1] = columns[2] = columns[3] = 0x1C;
+    } else {
+        ssd1306_draw_char(x, page, c);
+        return;
+    }
+
+    for (uint8_t i = 0; i < SSD1306_FONT_W; i++) {
+        ssd1306_fill(x + i, page, 1, 1, columns[i]);
+    }
+    ssd1306_fill(x + SSD1306_FONT_W, page, 1, 1, 0x00);
+#else
+    /* Printed whole on the next poll */
+    (void)row;
+    (void)window_col;
+    window_changed = true;
+#endif
+}
+
+#endif /* DISPLAY_TYPE != DISPLAY_LCD_1602 */
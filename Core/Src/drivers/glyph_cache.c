@@ -0,0 +1,320 @@
+/**
+  ******************************************************************************
+  * @file    glyph_cache.c
+  * @brief   CGRAM glyph cache for the HD44780 (8 slots, LRU).
+  * @note    Layouts ask for glyphs by ID; the cache maps them onto the 8
+  *          CGRAM slots and uploads only what is missing. Rewriting a slot
+  *          instantly changes every cell showing it, so the cache tracks
+  *          which glyph each cell shows: eviction prefers slots not on
+  *          screen, and cells hit by an unavoidable eviction are queued
+  *          for redraw.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "glyph_cache.h"
+#include "lcd1602_i2c.h"
+#include "stm32f4xx.h"
+#include "rtc_config.h"
+#include <stddef.h>
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define SLOT_EMPTY          GLYPH_NONE
+#define BKP_REG(n)          ((&RTC->BKP0R)[(n)])
+
+/* Private typedef -----------------------------------------------------------*/
+
+/**
+  * @brief  Cache state.
+  */
+typedef struct {
+    uint8_t slot_glyph[GLYPH_CACHE_SLOTS];      /*!< Glyph held by each slot */
+    uint32_t slot_last_use[GLYPH_CACHE_SLOTS];  /*!< LRU stamp */
+    uint8_t slot_refs[GLYPH_CACHE_SLOTS];       /*!< Cells currently showing it */
+    uint8_t cell_glyph[GLYPH_CACHE_ROWS][GLYPH_CACHE_COLS];  /*!< Glyph per cell */
+    uint32_t stale[GLYPH_CACHE_ROWS];           /*!< Cells needing redraw (bit = col) */
+    uint32_t clock;                             /*!< LRU time base */
+    uint32_t protected_cols;                    /*!< Columns whose slots are pinned */
+    glyph_cache_stats_t stats;
+} glyph_cache_t;
+
+/* Private variables ---------------------------------------------------------*/
+static glyph_cache_t cache;
+
+/* Private function prototypes -----------------------------------------------*/
+static void glyph_cache_save(void);
+static int8_t glyph_cache_acquire(uint8_t row, uint8_t col, glyph_id_t glyph);
+static int8_t glyph_cache_load(glyph_id_t glyph);
+static int8_t glyph_cache_pick_victim(void);
+static bool glyph_cache_slot_protected(uint8_t slot);
+
+/* Exported functions --------------------------------------------------------*/
+
+void glyph_cache_init(void) {
+    memset(cache.slot_glyph, SLOT_EMPTY, sizeof(cache.slot_glyph));
+    memset(cache.slot_last_use, 0, sizeof(cache.slot_last_use));
+    glyph_cache_screen_cleared();
+    cache.clock = 0;
+    cache.protected_cols = 0;
+
+    glyph_cache_save();
+}
+
+void glyph_cache_restore(void) {
+    uint32_t lo = BKP_REG(BKP_REG_GLYPH_SLOTS_LO);
+    uint32_t hi = BKP_REG(BKP_REG_GLYPH_SLOTS_HI);
+
+    for (uint8_t slot = 0; slot < GLYPH_CACHE_SLOTS; slot++) {
+        uint32_t word = (slot < 4) ? lo : hi;
+        uint8_t glyph = (uint8_t)(word >> ((slot & 3U) * 8));
+
+        cache.slot_glyph[slot] = (glyph < GLYPH_COUNT) ? glyph : SLOT_EMPTY;
+        cache.slot_last_use[slot] = 0;
+    }
+
+    /* The screen is redrawn after a reset - nothing on it is tracked */
+    glyph_cache_screen_cleared();
+    cache.clock = 0;
+    cache.protected_cols = 0;
+}
+
+bool glyph_cache_put(uint8_t row, uint8_t col, glyph_id_t glyph) {
+    int8_t slot = glyph_cache_acquire(row, col, glyph);
+
+    if (slot < 0) {
+        return false;
+    }
+
+    lcd_set_cursor(row, col);
+    lcd_write_custom_char((uint8_t)slot);
+    return true;
+}
+
+void glyph_cache_protect(uint8_t first_col, uint8_t count) {
+    uint32_t mask = 0;
+
+    for (uint8_t col = first_col; col < first_col + count && col < GLYPH_CACHE_COLS; col++) {
+        mask |= (1UL << col);
+    }
+    cache.protected_cols = mask;
+}
+
+void glyph_cache_screen_cleared(void) {
+    memset(cache.cell_glyph, SLOT_EMPTY, sizeof(cache.cell_glyph));
+    memset(cache.slot_refs, 0, sizeof(cache.slot_refs));
+    memset(cache.stale, 0, sizeof(cache.stale));
+}
+
+void glyph_cache_cell_overwritten(uint8_t row, uint8_t col) {
+    if (row >= GLYPH_CACHE_ROWS || col >= GLYPH_CACHE_COLS) {
+        return;
+    }
+
+    uint8_t old = cache.cell_glyph[row][col];
+    if (old == SLOT_EMPTY) {
+        return;
+    }
+
+    int8_t slot = glyph_cache_find((glyph_id_t)old);
+    if (slot >= 0 && cache.slot_refs[slot] > 0) {
+        cache.slot_refs[slot]--;
+    }
+
+    cache.cell_glyph[row][col] = SLOT_EMPTY;
+    cache.stale[row] &= ~(1UL << col);
+}
+
+uint8_t glyph_cache_redraw_stale(uint8_t first_col, uint8_t count) {
+    uint32_t window = 0;
+    uint32_t stale[GLYPH_CACHE_ROWS];
+    uint8_t glyphs[GLYPH_CACHE_ROWS][GLYPH_CACHE_COLS];
+    uint8_t redrawn = 0;
+
+    /* One pass over a snapshot: a redraw that evicts again (more than 8
+       distinct glyphs on screen) is picked up next frame, not looped on */
+    memcpy(stale, cache.stale, sizeof(stale));
+    memcpy(glyphs, cache.cell_glyph, sizeof(glyphs));
+
+    for (uint8_t col = first_col; col < first_col + count && col < GLYPH_CACHE_COLS; col++) {
+        window |= (1UL << col);
+    }
+
+    for (uint8_t row = 0; row < GLYPH_CACHE_ROWS; row++) {
+        for (uint32_t mask = stale[row] & window; mask != 0; mask &= mask - 1) {
+            uint8_t col = (uint8_t)__builtin_ctz(mask);
+
+            glyph_cache_put(row, col, (glyph_id_t)glyphs[row][col]);
+            redrawn++;
+        }
+    }
+
+    return redrawn;
+}
+
+int8_t glyph_cache_find(glyph_id_t glyph) {
+    for (uint8_t slot = 0; slot < GLYPH_CACHE_SLOTS; slot++) {
+        if (cache.slot_glyph[slot] == glyph) {
+            return (int8_t)slot;
+        }
+    }
+    return -1;
+}
+
+void glyph_cache_get_stats(glyph_cache_stats_t* stats) {
+    if (stats != NULL) {
+        *stats = cache.stats;
+    }
+}
+
+void glyph_cache_reset_stats(void) {
+    memset(&cache.stats, 0, sizeof(cache.stats));
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Persist the slot map for warm boots.
+  */
+static void glyph_cache_save(void) {
+    uint32_t lo = 0, hi = 0;
+
+    for (uint8_t slot = 0; slot < 4; slot++) {
+        lo |= (uint32_t)cache.slot_glyph[slot] << (slot * 8);
+        hi |= (uint32_t)cache.slot_glyph[slot + 4] << (slot * 8);
+    }
+
+    BKP_REG(BKP_REG_GLYPH_SLOTS_LO) = lo;
+    BKP_REG(BKP_REG_GLYPH_SLOTS_HI) = hi;
+}
+
+/**
+  * @brief  Make a glyph resident and record it at a cell without drawing it.
+  * @note   An upload moves the LCD address counter - set the cursor after.
+  * @retval CGRAM slot (0-7), or -1
+  */
+static int8_t glyph_cache_acquire(uint8_t row, uint8_t col, glyph_id_t glyph) {
+    if (row >= GLYPH_CACHE_ROWS || col >= GLYPH_CACHE_COLS || glyph >= GLYPH_COUNT) {
+        return -1;
+    }
+
+    glyph_cache_cell_overwritten(row, col);
+
+    int8_t slot = glyph_cache_load(glyph);
+    if (slot < 0) {
+        return -1;
+    }
+
+    cache.cell_glyph[row][col] = glyph;
+    cache.slot_refs[slot]++;
+    cache.stale[row] &= ~(1UL << col);
+
+    return slot;
+}
+
+/**
+  * @brief  Return the slot holding a glyph, uploading it if missing.
+  * @param  glyph: Glyph to load
+  * @retval CGRAM slot (0-7), or -1 if every slot is protected
+  */
+static int8_t glyph_cache_load(glyph_id_t glyph) {
+    int8_t found = glyph_cache_find(glyph);
+
+    cache.clock++;
+
+    if (found >= 0) {
+        cache.stats.hits++;
+        cache.slot_last_use[found] = cache.clock;
+        return found;
+    }
+
+    int8_t slot = glyph_cache_pick_victim();
+    if (slot < 0) {
+        return -1;
+    }
+    cache.stats.misses++;
+
+    if (cache.slot_glyph[slot] != SLOT_EMPTY) {
+        cache.stats.evictions++;
+
+        /* Cells still showing the old glyph would silently morph into the
+           new one - queue them for redraw */
+        uint8_t old = cache.slot_glyph[slot];
+        for (uint8_t row = 0; row < GLYPH_CACHE_ROWS; row++) {
+            for (uint8_t col = 0; col < GLYPH_CACHE_COLS; col++) {
+                if (cache.cell_glyph[row][col] == old) {
+                    cache.stale[row] |= (1UL << col);
+                    cache.stats.stale_cells++;
+                }
+            }
+        }
+        cache.slot_refs[slot] = 0;
+    }
+
+    /* A reset during the upload must not leave a warm boot trusting this
+       slot: persist it as empty first, the new glyph only once it is in */
+    cache.slot_glyph[slot] = SLOT_EMPTY;
+    glyph_cache_save();
+
+    lcd_create_char(slot, glyph_bitmaps[glyph]);
+    cache.stats.upload_bytes += GLYPH_UPLOAD_BYTES;
+
+    cache.slot_glyph[slot] = glyph;
+    cache.slot_last_use[slot] = cache.clock;
+    glyph_cache_save();
+
+    return slot;
+}
+
+/**
+  * @brief  Choose the slot to (re)fill.
+  * @note   Empty slot first, then the least recently used slot that no
+  *         cell shows, and only then the least recently used slot overall.
+  *         Slots shown in the protected columns are never chosen.
+  * @retval CGRAM slot (0-7), or -1 if all are protected
+  */
+static int8_t glyph_cache_pick_victim(void) {
+    int8_t best = -1;
+    bool best_free = false;
+
+    for (uint8_t slot = 0; slot < GLYPH_CACHE_SLOTS; slot++) {
+        if (cache.slot_glyph[slot] == SLOT_EMPTY) {
+            return (int8_t)slot;
+        }
+
+        if (glyph_cache_slot_protected(slot)) {
+            continue;
+        }
+
+        bool is_free = (cache.slot_refs[slot] == 0);
+
+        if (best < 0 || (is_free && !best_free) ||
+            (is_free == best_free && cache.slot_last_use[slot] < cache.slot_last_use[best])) {
+            best = (int8_t)slot;
+            best_free = is_free;
+        }
+    }
+
+    return best;
+}
+
+/**
+  * @brief  Check whether a slot is shown in a protected column.
+  * @param  slot: CGRAM slot
+  */
+static bool glyph_cache_slot_protected(uint8_t slot) {
+    if (cache.protected_cols == 0) {
+        return false;
+    }
+
+    for (uint8_t row = 0; row < GLYPH_CACHE_ROWS; row++) {
+        for (uint32_t mask = cache.protected_cols; mask != 0; mask &= mask - 1) {
+            uint8_t col = (uint8_t)__builtin_ctz(mask);
+
+            if (cache.cell_glyph[row][col] == cache.slot_glyph[slot]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
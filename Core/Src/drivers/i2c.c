@@ -1,4 +1,10 @@
 #include "i2c.h"
+#include "board_config.h"
+#include <stddef.h>
+
+/* Stream 6 flags live in HISR/HIFCR */
+#define I2C_TX_DMA_FLAGS (DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6 | \
+                          DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6)
 
 /* Private Variables */
 static volatile bool i2c_busy = false;
@@ -15,6 +21,66 @@ static void i2c_wait_busy_free(void) {
     }
 }
 
+/**
+  * @brief  Prepare the TX DMA stream (channel, direction and IRQs are
+  *         set per transfer)
+  */
+static void i2c_dma_init(void) {
+    I2C_TX_DMA_CLK_ENABLE();
+
+    I2C_TX_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+    while (I2C_TX_DMA_STREAM->CR & DMA_SxCR_EN);
+    I2C_TX_DMA_STREAM->PAR = (uint32_t)&I2C1->DR;
+    I2C_TX_DMA_STREAM->FCR = 0;                     /* Direct mode */
+    I2C_TX_DMA->HIFCR = I2C_TX_DMA_FLAGS;
+
+    NVIC_SetPriority(I2C_TX_DMA_IRQN, I2C_DMA_PRIORITY);
+    NVIC_EnableIRQ(I2C_TX_DMA_IRQN);
+    NVIC_SetPriority(I2C_EV_IRQN, I2C_DMA_PRIORITY);
+    NVIC_EnableIRQ(I2C_EV_IRQN);
+}
+
+/**
+  * @brief  START + address phase of a write
+  * @retval I2C_OK with ADDR set (not yet cleared), or the failure
+  * @note   Caller owns i2c_busy; on failure STOP is already issued
+  */
+static i2c_status_t i2c_start_write(uint8_t dev_addr) {
+    uint32_t timeout;
+
+    i2c_wait_busy_free();
+    if (i2c_last_error == I2C_TIMEOUT) {
+        return I2C_TIMEOUT;
+    }
+
+    I2C1->CR1 |= I2C_CR1_START;
+
+    timeout = 100000;
+    while (!(I2C1->SR1 & I2C_SR1_SB)) {
+        if (timeout-- == 0) {
+            I2C1->CR1 |= I2C_CR1_STOP;
+            return I2C_TIMEOUT;
+        }
+    }
+
+    I2C1->DR = dev_addr << 1;
+
+    timeout = 100000;
+    while (!(I2C1->SR1 & I2C_SR1_ADDR)) {
+        if (I2C1->SR1 & I2C_SR1_AF) {
+            I2C1->SR1 &= ~I2C_SR1_AF;
+            I2C1->CR1 |= I2C_CR1_STOP;
+            return I2C_ERROR;
+        }
+        if (timeout-- == 0) {
+            I2C1->CR1 |= I2C_CR1_STOP;
+            return I2C_TIMEOUT;
+        }
+    }
+
+    return I2C_OK;
+}
+
 /**
   * @brief  Initialize I2C1 peripheral
   */
@@ -49,6 +115,8 @@ void i2c_init(void) {
 
     i2c_busy = false;
     i2c_last_error = I2C_OK;
+
+    i2c_dma_init();
 }
 
 /**
@@ -174,3 +242,92 @@ i2c_status_t i2c_write_bytes(uint8_t dev_addr, const uint8_t* data, uint8_t len)
 
     return I2C_OK;
 }
+
+/**
+  * @brief  Write a buffer in one transaction using DMA (non-blocking)
+  * @param  dev_addr: 7-bit device address
+  * @param  data: Buffer to send (must stay valid until the transfer ends)
+  * @param  len: Number of bytes (1-65535)
+  * @retval I2C_OK if the transfer started
+  * @note   Byte writes return I2C_BUSY until the STOP has been issued
+  */
+i2c_status_t i2c_write_dma(uint8_t dev_addr, const uint8_t* data, uint16_t len) {
+    if (data == NULL || len == 0) return I2C_OK;
+
+    if (i2c_busy) return I2C_BUSY;
+    i2c_busy = true;
+    i2c_last_error = I2C_OK;
+
+    i2c_status_t status = i2c_start_write(dev_addr);
+    if (status != I2C_OK) {
+        i2c_last_error = status;
+        i2c_busy = false;
+        return status;
+    }
+
+    /* Memory -> I2C1->DR, bytes, memory increment */
+    I2C_TX_DMA_STREAM->CR = ((uint32_t)I2C_TX_DMA_CHANNEL << 25) |   /* CHSEL[27:25] */
+                            DMA_SxCR_MINC | DMA_SxCR_DIR_0 |
+                            DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+    I2C_TX_DMA_STREAM->M0AR = (uint32_t)data;
+    I2C_TX_DMA_STREAM->NDTR = len;
+    I2C_TX_DMA->HIFCR = I2C_TX_DMA_FLAGS;
+
+    /* DMAEN before clearing ADDR, so the first TXE goes to the DMA */
+    I2C1->CR2 |= I2C_CR2_DMAEN;
+    I2C_TX_DMA_STREAM->CR |= DMA_SxCR_EN;
+
+    volatile uint32_t tmp;
+    tmp = I2C1->SR1;
+    tmp = I2C1->SR2;
+    (void)tmp;
+
+    return I2C_OK;
+}
+
+/**
+  * @brief  True while a DMA write (or any transfer) owns the bus
+  */
+bool i2c_dma_busy(void) {
+    return i2c_busy;
+}
+
+/**
+  * @brief  Status of the last transfer
+  */
+i2c_status_t i2c_get_last_error(void) {
+    return i2c_last_error;
+}
+
+/**
+  * @brief  DMA1 Stream6 handler: all bytes handed to the I2C
+  */
+void i2c_dma_irq_handler(void) {
+    uint32_t hisr = I2C_TX_DMA->HISR;
+
+    I2C_TX_DMA->HIFCR = I2C_TX_DMA_FLAGS;
+    I2C1->CR2 &= ~I2C_CR2_DMAEN;
+
+    if (hisr & DMA_HISR_TEIF6) {
+        I2C1->CR1 |= I2C_CR1_STOP;
+        i2c_last_error = I2C_ERROR;
+        i2c_busy = false;
+        return;
+    }
+
+    if (hisr & DMA_HISR_TCIF6) {
+        /* Last byte is still shifting out: STOP once BTF is set */
+        I2C1->CR2 |= I2C_CR2_ITEVTEN;
+    }
+}
+
+/**
+  * @brief  I2C1 event handler: end of a DMA write
+  */
+void i2c_ev_irq_handler(void) {
+    if (I2C1->SR1 & I2C_SR1_BTF) {
+        I2C1->CR1 |= I2C_CR1_STOP;
+        I2C1->CR2 &= ~I2C_CR2_ITEVTEN;
+        i2c_busy = false;
+    }
+}
@@ -1,9 +1,60 @@
 #include "lcd1602_i2c.h"
 #include "i2c.h"
+#include "systick.h"
 #include <string.h>
 
+/* Private Types */
+typedef enum {
+    LCD_STEP_NIBBLE,        /* 8-bit mode command (high nibble only) */
+    LCD_STEP_BYTE           /* 4-bit mode command */
+} lcd_step_type_t;
+
+typedef struct {
+    lcd_step_type_t type;
+    uint8_t value;
+    uint8_t wait_ms;        /* Minimum time before the next step */
+} lcd_init_step_t;
+
+/* HD44780 4-bit init sequence. The datasheet's 150 us gaps are rounded
+   up to 1 ms (the systick resolution); a nibble already takes ~0.4 ms on
+   the 100 kHz bus. */
+static const lcd_init_step_t lcd_init_steps[] = {
+    { LCD_STEP_NIBBLE, 0x30, 5 },   /* Function set: 8-bit (wait > 4.1 ms) */
+    { LCD_STEP_NIBBLE, 0x30, 1 },   /* Function set: 8-bit */
+    { LCD_STEP_NIBBLE, 0x30, 1 },   /* Function set: 8-bit */
+    { LCD_STEP_NIBBLE, 0x20, 1 },   /* Function set: 4-bit */
+    { LCD_STEP_BYTE,   0x28, 0 },   /* Function set: 4-bit, 2-line, 5x8 dots */
+    { LCD_STEP_BYTE,   0x0C, 0 },   /* Display ON, cursor OFF, blink OFF */
+    { LCD_STEP_BYTE,   0x06, 0 },   /* Entry mode: increment, no shift */
+    { LCD_STEP_BYTE,   0x01, 2 },   /* Clear display (1.52 ms) */
+};
+
+/* Warm reset: the LCD kept power and its configuration, but the MCU may
+   have died between the two nibbles of a byte. Three 8-bit function sets
+   re-sync the nibble phase from any state; no power-up waits (the busy
+   time of a function set is 37 us) and no clear (the frame is redrawn). */
+static const lcd_init_step_t lcd_warm_init_steps[] = {
+    { LCD_STEP_NIBBLE, 0x30, 1 },   /* Function set: 8-bit (or 2nd half of a byte) */
+    { LCD_STEP_NIBBLE, 0x30, 1 },   /* Function set: 8-bit */
+    { LCD_STEP_NIBBLE, 0x30, 1 },   /* Function set: 8-bit */
+    { LCD_STEP_NIBBLE, 0x20, 0 },   /* Function set: 4-bit */
+    { LCD_STEP_BYTE,   0x28, 0 },   /* Function set: 4-bit, 2-line, 5x8 dots */
+    { LCD_STEP_BYTE,   0x0C, 0 },   /* Display ON, cursor OFF, blink OFF */
+    { LCD_STEP_BYTE,   0x06, 0 },   /* Entry mode: increment, no shift */
+    { LCD_STEP_BYTE,   0x02, 2 },   /* Return home: undo the last run's display shift */
+};
+
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
 /* Private Variables */
 static uint8_t backlight_state = LCD_BACKLIGHT;
+static const lcd_init_step_t* init_steps = lcd_init_steps;
+static uint8_t init_step_count = ARRAY_LEN(lcd_init_steps);
+static uint8_t init_step = 0;
+static uint32_t init_deadline = 0;
+static lcd_init_status_t init_status = LCD_INIT_IDLE;
+static uint32_t i2c_byte_count = 0;
+static uint8_t display_offset = 0;      /* DDRAM column at the left edge */
 
 /* Private Functions */
 static void delay_us(uint32_t us) {
@@ -22,6 +73,8 @@ static void lcd_send_nibble(uint8_t data, uint8_t rs) {
     /* Send with E=0 */
     i2c_write_byte(LCD_I2C_ADDR, byte);
     delay_us(10);
+
+    i2c_byte_count += 2;
 }
 
 static void lcd_send_byte(uint8_t data, uint8_t rs) {
@@ -33,36 +86,122 @@ static void lcd_send_byte(uint8_t data, uint8_t rs) {
 }
 
 /* Public Functions */
+
+/**
+  * @brief  Begin the non-blocking init sequence
+  * @note   The power-up wait counts from systick start (reset), so time
+  *         spent on other init before the first poll is not wasted.
+  */
+void lcd_init_start(void) {
+    init_steps = lcd_init_steps;
+    init_step_count = ARRAY_LEN(lcd_init_steps);
+    init_step = 0;
+    init_deadline = LCD_POWER_UP_MS;
+    init_status = LCD_INIT_BUSY;
+    display_offset = 0;
+}
+
+/**
+  * @brief  Begin the short re-sync sequence after a warm reset
+  * @note   Only valid when the LCD stayed powered and configured; the
+  *         display contents and CGRAM are left untouched.
+  */
+void lcd_init_start_warm(void) {
+    init_steps = lcd_warm_init_steps;
+    init_step_count = ARRAY_LEN(lcd_warm_init_steps);
+    init_step = 0;
+    init_deadline = systick_get_ticks();
+    init_status = LCD_INIT_BUSY;
+    display_offset = 0;
+}
+
+/**
+  * @brief  Advance the init sequence by at most one step
+  * @retval true once the LCD accepts normal commands
+  * @note   Call repeatedly from the main loop; never waits
+  */
+bool lcd_init_poll(void) {
+    if (init_status != LCD_INIT_BUSY) {
+        return init_status == LCD_INIT_DONE;
+    }
+
+    if ((int32_t)(systick_get_ticks() - init_deadline) < 0) {
+        return false;
+    }
+
+    if (init_step >= init_step_count) {
+        init_status = LCD_INIT_DONE;
+        return true;
+    }
+
+    const lcd_init_step_t* step = &init_steps[init_step++];
+    if (step->type == LCD_STEP_NIBBLE) {
+        lcd_send_nibble(step->value, 0);
+    } else {
+        lcd_send_byte(step->value, 0);
+    }
+
+    /* +1: the current tick may already be almost over */
+    init_deadline = systick_get_ticks() + step->wait_ms + 1U;
+    return false;
+}
+
+/**
+  * @brief  Get init sequence state
+  */
+lcd_init_status_t lcd_init_get_status(void) {
+    return init_status;
+}
+
+/**
+  * @brief  Blocking init (runs the same sequence to completion)
+  */
 void lcd_init(void) {
-    /* Wait for LCD power-up */
-    delay_us(50000);
-
-    /* Initialization sequence for 4-bit mode */
-    lcd_send_nibble(0x30, 0);  /* Function set: 8-bit */
-    delay_us(4500);
-    lcd_send_nibble(0x30, 0);  /* Function set: 8-bit */
-    delay_us(150);
-    lcd_send_nibble(0x30, 0);  /* Function set: 8-bit */
-    delay_us(150);
-    lcd_send_nibble(0x20, 0);  /* Function set: 4-bit */
-    delay_us(150);
-
-    /* Now we can use lcd_send_byte for 4-bit mode */
-    lcd_send_byte(0x28, 0);    /* Function set: 4-bit, 2-line, 5x8 dots */
-    lcd_send_byte(0x0C, 0);    /* Display ON, cursor OFF, blink OFF */
-    lcd_send_byte(0x06, 0);    /* Entry mode: increment, no shift */
-    lcd_send_byte(0x01, 0);    /* Clear display */
-    delay_us(2000);
+    lcd_init_start();
+    while (!lcd_init_poll());
 }
 
 void lcd_clear(void) {
     lcd_send_byte(0x01, 0);
     delay_us(2000);
+    display_offset = 0;
 }
 
 void lcd_home(void) {
     lcd_send_byte(0x02, 0);
     delay_us(2000);
+    display_offset = 0;
+}
+
+/**
+  * @brief  Scroll the 16-column window over the 40-column DDRAM rows
+  * @param  offset: DDRAM column to show at the left edge (0-39)
+  * @note   Shifts both rows; DDRAM contents and CGRAM are untouched.
+  *         Uses the shorter direction, or return home for offset 0.
+  */
+void lcd_set_display_offset(uint8_t offset) {
+    if (offset >= LCD_DDRAM_COLS || offset == display_offset) return;
+
+    if (offset == 0) {
+        lcd_home();
+        return;
+    }
+
+    uint8_t left = (uint8_t)((offset + LCD_DDRAM_COLS - display_offset) % LCD_DDRAM_COLS);
+    uint8_t right = (uint8_t)(LCD_DDRAM_COLS - left);
+
+    /* Display shift: 0x18 = left (window moves right), 0x1C = right */
+    if (left <= right) {
+        while (left--) lcd_send_byte(0x18, 0);
+    } else {
+        while (right--) lcd_send_byte(0x1C, 0);
+    }
+
+    display_offset = offset;
+}
+
+uint8_t lcd_get_display_offset(void) {
+    return display_offset;
 }
 
 void lcd_set_cursor(uint8_t row, uint8_t col) {
@@ -90,11 +229,20 @@ void lcd_write_string(const char* str) {
 void lcd_backlight_on(void) {
     backlight_state = LCD_BACKLIGHT;
     i2c_write_byte(LCD_I2C_ADDR, backlight_state);
+    i2c_byte_count++;
 }
 
 void lcd_backlight_off(void) {
     backlight_state = 0;
     i2c_write_byte(LCD_I2C_ADDR, backlight_state);
+    i2c_byte_count++;
+}
+
+/**
+  * @brief  PCF8574 data bytes sent since boot (4 per LCD command/char)
+  */
+uint32_t lcd_get_i2c_byte_count(void) {
+    return i2c_byte_count;
 }
 
 
@@ -2,6 +2,7 @@
 #include "board_config.h"
 #include "stm32f4xx.h"
 #include "systick.h"
+#include "led_pattern.h"
 
 // Convert LED ID to GPIO pin
 static uint16_t led_id_to_pin(led_id_t led) {
@@ -130,47 +131,18 @@ void led_set_pattern(uint8_t pattern) {
     if (pattern & 0x08) led_on(LED_BLUE);    // Bit 3: Blue
 }
 
-// Simple blocking delay (temporary - will be replaced by systick)
-static void delay_ms_blocking(uint32_t ms) {
-    for (uint32_t i = 0; i < ms * 1600; i++) {
-        __NOP();
-    }
-}
-
+// Animations are played by the DMA sequencer - calling again while the
+// same pattern runs is a no-op, so these are safe to call from a loop
 void led_chase(uint32_t delay_ms) {
-    static uint8_t chase_state = 0;
-
-    led_all_off();
-
-    switch (chase_state) {
-        case 0: led_on(LED_GREEN); break;
-        case 1: led_on(LED_ORANGE); break;
-        case 2: led_on(LED_RED); break;
-        case 3: led_on(LED_BLUE); break;
+    if (!led_pattern_is_playing(&led_pattern_chase)) {
+        led_pattern_start(&led_pattern_chase, delay_ms, LED_PATTERN_CIRCULAR);
     }
-
-    chase_state = (chase_state + 1) % 4;
-    delay_ms_blocking(delay_ms);
 }
 
 void led_knight_rider(void) {
-    static int8_t direction = 1;
-    static uint8_t position = 0;
-
-    led_all_off();
-
-    // Light current position
-    led_set((led_id_t)position, true);
-
-    // Update position
-    position += direction;
-
-    // Reverse direction at ends
-    if (position == 0 || position == LED_COUNT - 1) {
-        direction = -direction;
+    if (!led_pattern_is_playing(&led_pattern_knight_rider)) {
+        led_pattern_start(&led_pattern_knight_rider, 200, LED_PATTERN_CIRCULAR);
     }
-
-    delay_ms_blocking(200);
 }
 
 // SIMPLE Blink - uses counter instead of time
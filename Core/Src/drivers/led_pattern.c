@@ -0,0 +1,145 @@
+#include "led_pattern.h"
+#include "clock.h"
+#include "stm32f4xx.h"
+#include <stddef.h>
+
+//================================
+// Pattern tables
+//================================
+
+static const uint32_t chase_steps[] = {
+    LED_BSRR(LED_GREEN_PIN_MSK),
+    LED_BSRR(LED_ORANGE_PIN_MSK),
+    LED_BSRR(LED_RED_PIN_MSK),
+    LED_BSRR(LED_BLUE_PIN_MSK),
+};
+
+static const uint32_t knight_rider_steps[] = {
+    LED_BSRR(LED_GREEN_PIN_MSK),
+    LED_BSRR(LED_ORANGE_PIN_MSK),
+    LED_BSRR(LED_RED_PIN_MSK),
+    LED_BSRR(LED_BLUE_PIN_MSK),
+    LED_BSRR(LED_RED_PIN_MSK),
+    LED_BSRR(LED_ORANGE_PIN_MSK),
+};
+
+static const uint32_t alarm_steps[] = {
+    LED_BSRR(LED_GREEN_PIN_MSK | LED_RED_PIN_MSK),
+    LED_BSRR(LED_ORANGE_PIN_MSK | LED_BLUE_PIN_MSK),
+    LED_BSRR(LED_GREEN_PIN_MSK | LED_RED_PIN_MSK),
+    LED_BSRR(LED_ORANGE_PIN_MSK | LED_BLUE_PIN_MSK),
+    LED_BSRR(LED_ALL_PINS),
+    LED_BSRR(0),
+};
+
+static const uint32_t blink_all_steps[] = {
+    LED_BSRR(LED_ALL_PINS),
+    LED_BSRR(0),
+};
+
+#define PATTERN(table) { (table), (uint16_t)(sizeof(table) / sizeof((table)[0])) }
+
+const led_pattern_t led_pattern_chase        = PATTERN(chase_steps);
+const led_pattern_t led_pattern_knight_rider = PATTERN(knight_rider_steps);
+const led_pattern_t led_pattern_alarm        = PATTERN(alarm_steps);
+const led_pattern_t led_pattern_blink_all    = PATTERN(blink_all_steps);
+
+//================================
+// Sequencer
+//================================
+
+// Stream 1 flags live in LISR/LIFCR
+#define STREAM_FLAGS (DMA_LIFCR_CTCIF1 | DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTEIF1 | \
+                      DMA_LIFCR_CDMEIF1 | DMA_LIFCR_CFEIF1)
+
+static const led_pattern_t* current_pattern = NULL;
+
+static void led_pattern_halt(void) {
+    LED_PATTERN_TIMER->CR1 &= ~TIM_CR1_CEN;
+    LED_PATTERN_TIMER->DIER &= ~TIM_DIER_UDE;
+
+    LED_PATTERN_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+    while (LED_PATTERN_DMA_STREAM->CR & DMA_SxCR_EN);   // Stream stops after current beat
+    LED_PATTERN_DMA->LIFCR = STREAM_FLAGS;
+
+    current_pattern = NULL;
+}
+
+void led_pattern_init(void) {
+    // 1. Enable clocks (LED GPIO is set up by led_init)
+    LED_PATTERN_CLK_ENABLE();
+
+    // 2. Timer: free-running time base, update event = DMA request
+    //    (TIM8 is on APB2: its clock follows the PPRE2 divider)
+    LED_PATTERN_TIMER->CR1 = 0;
+    LED_PATTERN_TIMER->PSC = (clock_apb2_timer_hz() / (1000000U / LED_PATTERN_TICK_US)) - 1U;
+    LED_PATTERN_TIMER->DIER = 0;
+
+    // 3. Stream: memory -> peripheral, 32-bit words, memory increment
+    LED_PATTERN_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+    while (LED_PATTERN_DMA_STREAM->CR & DMA_SxCR_EN);
+    LED_PATTERN_DMA_STREAM->PAR = (uint32_t)&LED_GPIO_PORT->BSRR;
+    LED_PATTERN_DMA_STREAM->FCR = 0;                    // Direct mode
+    LED_PATTERN_DMA->LIFCR = STREAM_FLAGS;
+
+    NVIC_SetPriority(LED_PATTERN_DMA_IRQN, LED_PATTERN_PRIORITY);
+    NVIC_EnableIRQ(LED_PATTERN_DMA_IRQN);
+}
+
+bool led_pattern_start(const led_pattern_t* pattern, uint32_t step_ms, led_pattern_mode_t mode) {
+    uint32_t ticks = (step_ms * 1000U) / LED_PATTERN_TICK_US;
+
+    if (pattern == NULL || pattern->steps == NULL || pattern->length == 0 ||
+        ticks < 1 || ticks > 65536U) {
+        return false;
+    }
+
+    led_pattern_halt();
+
+    // 1. Stream for this table
+    uint32_t cr = ((uint32_t)LED_PATTERN_DMA_CHANNEL << 25) |     // CHSEL[27:25]
+                  DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1 |     // 32-bit both sides
+                  DMA_SxCR_MINC | DMA_SxCR_DIR_0;           // Memory to peripheral
+    if (mode == LED_PATTERN_CIRCULAR) {
+        cr |= DMA_SxCR_CIRC;
+    } else {
+        cr |= DMA_SxCR_TCIE;                                // Stop timer at the end
+    }
+
+    LED_PATTERN_DMA_STREAM->CR = cr;
+    LED_PATTERN_DMA_STREAM->M0AR = (uint32_t)pattern->steps;
+    LED_PATTERN_DMA_STREAM->NDTR = pattern->length;
+    LED_PATTERN_DMA_STREAM->CR |= DMA_SxCR_EN;
+
+    current_pattern = pattern;
+
+    // 2. Timer paces the steps; UG loads PSC/ARR and requests step 0 now
+    LED_PATTERN_TIMER->ARR = ticks - 1U;
+    LED_PATTERN_TIMER->CNT = 0;
+    LED_PATTERN_TIMER->DIER = TIM_DIER_UDE;
+    LED_PATTERN_TIMER->EGR = TIM_EGR_UG;
+    LED_PATTERN_TIMER->CR1 |= TIM_CR1_CEN;
+
+    return true;
+}
+
+void led_pattern_stop(void) {
+    led_pattern_halt();
+}
+
+bool led_pattern_is_running(void) {
+    return current_pattern != NULL;
+}
+
+bool led_pattern_is_playing(const led_pattern_t* pattern) {
+    return pattern != NULL && current_pattern == pattern;
+}
+
+void led_pattern_dma_irq_handler(void) {
+    if (LED_PATTERN_DMA->LISR & DMA_LISR_TCIF1) {
+        // One-shot finished: last step stays on the pins
+        led_pattern_halt();
+    } else {
+        LED_PATTERN_DMA->LIFCR = STREAM_FLAGS;
+    }
+}
@@ -0,0 +1,153 @@
+#include "led_pwm.h"
+#include "led.h"
+#include "board_config.h"
+#include "clock.h"
+#include "stm32f4xx.h"
+
+// Duty per LED in permille - kept so period changes preserve brightness
+static uint16_t duty_permille[LED_COUNT] = {0};
+
+// LEDs currently routed to TIM4 (bit = led_id_t)
+static uint8_t attached_mask = 0;
+
+// Convert LED ID to pin number
+static uint32_t led_id_to_pin_num(led_id_t led) {
+    switch (led) {
+        case LED_GREEN:  return LED_GREEN_PIN_NUM;
+        case LED_ORANGE: return LED_ORANGE_PIN_NUM;
+        case LED_RED:    return LED_RED_PIN_NUM;
+        case LED_BLUE:   return LED_BLUE_PIN_NUM;
+        default:         return 0;
+    }
+}
+
+// CCR1..CCR4 are consecutive: channel = led + 1
+static volatile uint32_t* led_ccr(led_id_t led) {
+    return &LED_PWM_TIMER->CCR1 + led;
+}
+
+static void led_pwm_apply_duty(led_id_t led) {
+    uint32_t ticks = LED_PWM_TIMER->ARR + 1U;
+    *led_ccr(led) = (ticks * duty_permille[led]) / 1000U;
+}
+
+static void led_pwm_attach(led_id_t led) {
+    if (attached_mask & (1U << led)) return;
+
+    uint32_t pin = led_id_to_pin_num(led);
+
+    // AFR[1] holds pins 8-15
+    LED_GPIO_PORT->AFR[1] &= ~(0xFU << ((pin - 8) * 4));
+    LED_GPIO_PORT->AFR[1] |= ((uint32_t)LED_PWM_AF << ((pin - 8) * 4));
+
+    // MODER: Alternate function
+    LED_GPIO_PORT->MODER &= ~(3U << (pin * 2));
+    LED_GPIO_PORT->MODER |= (2U << (pin * 2));
+
+    LED_PWM_TIMER->CCER |= (TIM_CCER_CC1E << (led * 4));
+    attached_mask |= (uint8_t)(1U << led);
+}
+
+void led_pwm_init(void) {
+    // 1. Enable TIM4 clock (APB1 timer clock, follows the PPRE1 divider)
+    LED_PWM_CLK_ENABLE();
+
+    // 2. Time base: LED_PWM_TICK_US per count
+    LED_PWM_TIMER->CR1 = 0;
+    LED_PWM_TIMER->PSC = (clock_apb1_timer_hz() / (1000000U / LED_PWM_TICK_US)) - 1U;
+    LED_PWM_TIMER->ARR = (LED_PWM_DIM_PERIOD_US / LED_PWM_TICK_US) - 1U;
+
+    // 3. PWM mode 1 with preload on all channels: CCR updates land on the
+    //    next period boundary, so duty changes never glitch
+    LED_PWM_TIMER->CCMR1 = TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE |
+                           TIM_CCMR1_OC2M_2 | TIM_CCMR1_OC2M_1 | TIM_CCMR1_OC2PE;
+    LED_PWM_TIMER->CCMR2 = TIM_CCMR2_OC3M_2 | TIM_CCMR2_OC3M_1 | TIM_CCMR2_OC3PE |
+                           TIM_CCMR2_OC4M_2 | TIM_CCMR2_OC4M_1 | TIM_CCMR2_OC4PE;
+    LED_PWM_TIMER->CCER = 0;
+    LED_PWM_TIMER->CCR1 = 0;
+    LED_PWM_TIMER->CCR2 = 0;
+    LED_PWM_TIMER->CCR3 = 0;
+    LED_PWM_TIMER->CCR4 = 0;
+
+    // 4. Load registers and start
+    LED_PWM_TIMER->CR1 = TIM_CR1_ARPE;
+    LED_PWM_TIMER->EGR = TIM_EGR_UG;
+    LED_PWM_TIMER->CR1 |= TIM_CR1_CEN;
+
+    attached_mask = 0;
+}
+
+bool led_pwm_set_period_us(uint32_t period_us) {
+    uint32_t ticks = period_us / LED_PWM_TICK_US;
+    if (ticks < 2 || ticks > 65536U) return false;
+
+    LED_PWM_TIMER->ARR = ticks - 1U;
+    for (led_id_t led = LED_GREEN; led < LED_COUNT; led++) {
+        led_pwm_apply_duty(led);
+    }
+    return true;
+}
+
+uint32_t led_pwm_get_period_us(void) {
+    return (LED_PWM_TIMER->ARR + 1U) * LED_PWM_TICK_US;
+}
+
+void led_pwm_set_duty(led_id_t led, uint16_t permille) {
+    if (permille > 1000) permille = 1000;
+
+    if (led == LED_ALL) {
+        for (led_id_t i = LED_GREEN; i < LED_COUNT; i++) {
+            led_pwm_set_duty(i, permille);
+        }
+        return;
+    }
+
+    if (led < LED_COUNT) {
+        duty_permille[led] = permille;
+        led_pwm_apply_duty(led);
+        led_pwm_attach(led);
+    }
+}
+
+void led_pwm_set_brightness(led_id_t led, uint8_t percent) {
+    if (percent > 100) percent = 100;
+
+    led_pwm_set_period_us(LED_PWM_DIM_PERIOD_US);
+    led_pwm_set_duty(led, (uint16_t)percent * 10U);
+}
+
+bool led_pwm_blink(led_id_t led, uint32_t on_time_ms, uint32_t off_time_ms) {
+    if (on_time_ms == 0 || off_time_ms == 0) return false;
+
+    uint32_t period_ms = on_time_ms + off_time_ms;
+    if (!led_pwm_set_period_us(period_ms * 1000U)) return false;
+
+    led_pwm_set_duty(led, (uint16_t)((on_time_ms * 1000U) / period_ms));
+    return true;
+}
+
+void led_pwm_release(led_id_t led) {
+    if (led == LED_ALL) {
+        for (led_id_t i = LED_GREEN; i < LED_COUNT; i++) {
+            led_pwm_release(i);
+        }
+        return;
+    }
+
+    if (led >= LED_COUNT || !(attached_mask & (1U << led))) return;
+
+    uint32_t pin = led_id_to_pin_num(led);
+
+    LED_PWM_TIMER->CCER &= ~(TIM_CCER_CC1E << (led * 4));
+    duty_permille[led] = 0;
+    attached_mask &= (uint8_t)~(1U << led);
+
+    // Back to GPIO output, OFF
+    led_off(led);
+    LED_GPIO_PORT->MODER &= ~(3U << (pin * 2));
+    LED_GPIO_PORT->MODER |= (1U << (pin * 2));
+}
+
+bool led_pwm_is_attached(led_id_t led) {
+    return (led < LED_COUNT) && (attached_mask & (1U << led)) != 0;
+}
@@ -17,6 +17,12 @@
 #define RTC_IS_IN_INIT_MODE()    ((RTC->ISR & RTC_ISR_INITF) != 0)
 #define RTC_IS_SYNCHRONIZED()    ((RTC->ISR & RTC_ISR_RSF) != 0)
 
+/* ISR flags are rc_w0: clear with a plain write of 0 to the flag and 1 to
+   the others (no effect), never read-modify-write - a flag set between
+   the read and the write would be cleared too. INIT is the only rw bit. */
+#define RTC_ISR_CLEAR_FLAG(flag) \
+    (RTC->ISR = ~((flag) | RTC_ISR_INIT) | (RTC->ISR & RTC_ISR_INIT))
+
 
 
 /* Private Function Prototypes -----------------------------------------------*/
@@ -271,11 +277,26 @@ void rtc_get_date(rtc_date_t* date) {
     date->weekday = (dr >> 13) & 0x07;
 }
 
+/**
+  * @brief  Time elapsed since the last second increment
+  * @note   SSR counts down from PREDIV_S to 0 within each second
+  */
+uint32_t rtc_get_subsecond_us(void) {
+    /* SSR first: it freezes TR/DR shadows until DR is read */
+    uint32_t ssr = RTC->SSR & 0xFFFFU;
+    (void)RTC->DR;
+
+    if (ssr > RTC_SYNC_PRESCALER) {
+        return 0;   /* Just after a shift operation */
+    }
+    return (RTC_SYNC_PRESCALER - ssr) * 1000000U / (RTC_SYNC_PRESCALER + 1U);
+}
+
 /**
   * @brief  Wait for RTC registers synchronization
   */
 bool rtc_wait_for_sync(uint32_t timeout) {
-	RTC->ISR &= ~RTC_ISR_RSF;  /* Clear flag for next read */
+	RTC_ISR_CLEAR_FLAG(RTC_ISR_RSF);  /* Clear flag for next read */
 
     while (!RTC_IS_SYNCHRONIZED()) {
         if (timeout-- == 0) {
@@ -332,6 +353,12 @@ static bool clock_source_init(void) {
         return true;
 
     #elif RTC_SOURCE == RTC_CLOCK_SOURCE_LSE
+        /* Warm reset: LSE survives in the backup domain - restarting it
+           would stall the running calendar */
+        if (RCC->BDCR & RCC_BDCR_LSERDY) {
+            return true;
+        }
+
         /* First disable LSE if it was enabled */
         RCC->BDCR &= ~RCC_BDCR_LSEON;
 
@@ -376,7 +403,10 @@ static bool clock_source_init(void) {
   * @brief  Initialize RTC clock
   */
 static bool rtc_clock_init(void) {
-
+    /* Warm reset: RTC already clocked (RTCSEL is write-once anyway) */
+    if (RCC->BDCR & RCC_BDCR_RTCEN) {
+        return true;
+    }
 
     /* Select RTC clock source */
     RCC->BDCR &= ~RCC_BDCR_RTCSEL;
@@ -417,7 +447,7 @@ static void rtc_write_protection_enable(void) {
 static bool rtc_enter_init_mode(void) {
     rtc_write_protection_disable();
 
-    RTC->ISR |= RTC_ISR_INIT;
+    RTC->ISR = 0xFFFFFFFFU;     /* INIT = 1, rc_w0 flags untouched */
 
     uint32_t timeout = RTC_INIT_TIMEOUT;
     while (!RTC_IS_IN_INIT_MODE()) {
@@ -434,7 +464,7 @@ static bool rtc_enter_init_mode(void) {
   * @brief  Exit initialization mode safely
   */
 static bool rtc_exit_init_mode(void) {
-    RTC->ISR &= ~RTC_ISR_INIT;
+    RTC->ISR = ~RTC_ISR_INIT;   /* Leaves every rc_w0 flag untouched */
     rtc_write_protection_enable();
 
     /* Verify we exited init mode */
@@ -488,10 +518,19 @@ static bool validate_date(const rtc_date_t* date) {
 
 #if RTC_ALARM_ENABLE
 
+/* Private alarm variables */
+static uint16_t alarm_programmed_ss[2];     /* SS value each alarm matches on */
+static uint8_t alarm_programmed_maskss[2];  /* MASKSS of each alarm */
+static rtc_alarm_jitter_t alarm_jitter[2];
+
 /* Private alarm functions */
 static void rtc_alarm_exti_config(void);
 static void rtc_alarm_nvic_config(void);
-static bool rtc_wait_for_alarm_write(uint32_t timeout);
+static bool rtc_wait_for_alarm_write(rtc_alarm_id_t id, uint32_t timeout);
+static uint32_t rtc_alarm_enable_bit(rtc_alarm_id_t id);
+static uint32_t rtc_alarm_irq_bit(rtc_alarm_id_t id);
+static uint32_t rtc_alarm_flag_bit(rtc_alarm_id_t id);
+static void rtc_alarm_record_jitter(rtc_alarm_id_t id, uint32_t ssr);
 
 /**
   * @brief  Configure EXTI for RTC alarm
@@ -520,8 +559,10 @@ static void rtc_alarm_nvic_config(void) {
 /**
   * @brief  Wait for alarm register to be writable
   */
-static bool rtc_wait_for_alarm_write(uint32_t timeout) {
-    while ((RTC->ISR & RTC_ISR_ALRAWF) == 0) {
+static bool rtc_wait_for_alarm_write(rtc_alarm_id_t id, uint32_t timeout) {
+    uint32_t write_flag = (id == RTC_ALARM_B) ? RTC_ISR_ALRBWF : RTC_ISR_ALRAWF;
+
+    while ((RTC->ISR & write_flag) == 0) {
         if (timeout-- == 0) {
             return false;
         }
@@ -529,12 +570,27 @@ static bool rtc_wait_for_alarm_write(uint32_t timeout) {
     return true;
 }
 
+/**
+  * @brief  Per-alarm register bits
+  */
+static uint32_t rtc_alarm_enable_bit(rtc_alarm_id_t id) {
+    return (id == RTC_ALARM_B) ? RTC_CR_ALRBE : RTC_CR_ALRAE;
+}
+
+static uint32_t rtc_alarm_irq_bit(rtc_alarm_id_t id) {
+    return (id == RTC_ALARM_B) ? RTC_CR_ALRBIE : RTC_CR_ALRAIE;
+}
+
+static uint32_t rtc_alarm_flag_bit(rtc_alarm_id_t id) {
+    return (id == RTC_ALARM_B) ? RTC_ISR_ALRBF : RTC_ISR_ALRAF;
+}
+
 /**
   * @brief  Initialize RTC alarm system
   */
 bool rtc_alarm_init(void) {
     /* Check if alarms are enabled in config */
-    #if RTC_ALARM_A_ENABLE == 0
+    #if RTC_ALARM_A_ENABLE == 0 && RTC_ALARM_B_ENABLE == 0
         return false;
     #endif
 
@@ -546,8 +602,13 @@ bool rtc_alarm_init(void) {
     /* Disable write protection */
     rtc_write_protection_disable();
 
-    /* Enable Alarm A interrupt in RTC */
-    RTC->CR |= RTC_CR_ALRAIE;
+    /* Enable alarm interrupts in RTC */
+    #if RTC_ALARM_A_ENABLE
+        RTC->CR |= RTC_CR_ALRAIE;
+    #endif
+    #if RTC_ALARM_B_ENABLE
+        RTC->CR |= RTC_CR_ALRBIE;
+    #endif
 
     /* Re-enable write protection */
     rtc_write_protection_enable();
@@ -562,10 +623,14 @@ bool rtc_alarm_init(void) {
 }
 
 /**
-  * @brief  Set alarm A configuration
+  * @brief  Set alarm configuration
   */
-bool rtc_set_alarm_a(const rtc_alarm_t* alarm) {
-    if (alarm == NULL) {
+bool rtc_set_alarm(rtc_alarm_id_t id, const rtc_alarm_t* alarm) {
+    if (alarm == NULL || id > RTC_ALARM_B) {
+        return false;
+    }
+
+    if (alarm->millisecond > 999 || alarm->subsecond_mask > RTC_ALARM_SS_MASK_ALL) {
         return false;
     }
 
@@ -573,112 +638,192 @@ bool rtc_set_alarm_a(const rtc_alarm_t* alarm) {
     rtc_write_protection_disable();
 
     /* Disable alarm first (required before configuration) */
-    RTC->CR &= ~RTC_CR_ALRAE;
+    RTC->CR &= ~rtc_alarm_enable_bit(id);
 
     /* Wait for alarm register to be writable */
-    if (!rtc_wait_for_alarm_write(RTC_ALARM_A_TIMEOUT)) {
+    uint32_t timeout = (id == RTC_ALARM_B) ? RTC_ALARM_B_TIMEOUT : RTC_ALARM_A_TIMEOUT;
+    if (!rtc_wait_for_alarm_write(id, timeout)) {
         rtc_write_protection_enable();
         return false;
     }
 
     /* Configure alarm register */
-    uint32_t alrmar = 0;
+    uint32_t alrmr = 0;
 
     /* Set time components */
-    alrmar |= (bin_to_bcd(alarm->second) << 0);
-    alrmar |= (bin_to_bcd(alarm->minute) << 8);
-    alrmar |= (bin_to_bcd(alarm->hour) << 16);
+    alrmr |= (bin_to_bcd(alarm->second) << 0);
+    alrmr |= (bin_to_bcd(alarm->minute) << 8);
+    alrmr |= (bin_to_bcd(alarm->hour) << 16);
 
     /* Configure mask bits */
-    if (alarm->mask & RTC_ALARM_MASK_SECONDS) alrmar |=(1 << 7);   /* MSK1 */
-    if (alarm->mask & RTC_ALARM_MASK_MINUTES) alrmar |= (1 << 15);  /* MSK2 */
-    if (alarm->mask & RTC_ALARM_MASK_HOURS) alrmar |= (1 << 23);    /* MSK3 */
-    if (alarm->mask & RTC_ALARM_MASK_DATE) alrmar |= (1 << 31);     /* MSK4 */
+    if (alarm->mask & RTC_ALARM_MASK_SECONDS) alrmr |= (1 << 7);    /* MSK1 */
+    if (alarm->mask & RTC_ALARM_MASK_MINUTES) alrmr |= (1 << 15);   /* MSK2 */
+    if (alarm->mask & RTC_ALARM_MASK_HOURS) alrmr |= (1 << 23);     /* MSK3 */
+    if (alarm->mask & RTC_ALARM_MASK_DATE) alrmr |= (1U << 31);     /* MSK4 */
 
     /* Configure weekday if specified */
     if (alarm->weekday != 0) {
-        alrmar |= (1 << 24);  /* WDSEL = 1: compare with weekday */
-        alrmar |= ((alarm->weekday & 0x07) << 13);
+        alrmr |= (1 << 24);  /* WDSEL = 1: compare with weekday */
+        alrmr |= ((alarm->weekday & 0x07) << 13);
+    }
+
+    /* Sub-second match: SS counts down from PREDIV_S within each second */
+    uint32_t ss = RTC_SYNC_PRESCALER -
+                  ((uint32_t)alarm->millisecond * (RTC_SYNC_PRESCALER + 1U)) / 1000U;
+    uint32_t alrmssr = (ss & 0x7FFFU) | ((uint32_t)alarm->subsecond_mask << 24);
+
+    /* Write to alarm registers */
+    if (id == RTC_ALARM_B) {
+        RTC->ALRMBR = alrmr;
+        RTC->ALRMBSSR = alrmssr;
+    } else {
+        RTC->ALRMAR = alrmr;
+        RTC->ALRMASSR = alrmssr;
     }
 
-    /* Write to alarm register */
-    RTC->ALRMAR = alrmar;
+    alarm_programmed_ss[id] = (alarm->subsecond_mask != 0) ? (uint16_t)ss : RTC_SYNC_PRESCALER;
+    alarm_programmed_maskss[id] = alarm->subsecond_mask;
 
     /* Clear any pending alarm flag */
-    RTC->ISR &= ~RTC_ISR_ALRAF;
+    RTC_ISR_CLEAR_FLAG(rtc_alarm_flag_bit(id));
 
     /* Re-enable write protection */
     rtc_write_protection_enable();
 
     /* Enable alarm if requested */
     if (alarm->enabled) {
-        rtc_alarm_a_enable();
+        rtc_alarm_enable(id);
     }
 
     return true;
 }
 
 /**
-  * @brief  Enable alarm A
+  * @brief  Enable alarm
   */
-void rtc_alarm_a_enable(void) {
+void rtc_alarm_enable(rtc_alarm_id_t id) {
     rtc_write_protection_disable();
 
-    /* Enable alarm A */
-    RTC->CR |= RTC_CR_ALRAE;
-
-    /* Ensure interrupt is enabled */
-    RTC->CR |= RTC_CR_ALRAIE;
+    /* Enable alarm and make sure its interrupt is enabled */
+    RTC->CR |= rtc_alarm_enable_bit(id) | rtc_alarm_irq_bit(id);
 
     rtc_write_protection_enable();
 }
 
 /**
-  * @brief  Disable alarm A
+  * @brief  Disable alarm
   */
-void rtc_alarm_a_disable(void) {
+void rtc_alarm_disable(rtc_alarm_id_t id) {
     rtc_write_protection_disable();
 
-    /* Disable alarm A */
-    RTC->CR &= ~RTC_CR_ALRAE;
-
-    /* Keep interrupt enabled for future use */
-    // RTC->CR &= ~RTC_CR_ALRAIE;  /* Uncomment to disable interrupt too */
+    /* Disable alarm, keep interrupt enabled for future use */
+    RTC->CR &= ~rtc_alarm_enable_bit(id);
 
     rtc_write_protection_enable();
 }
 
 /**
-  * @brief  Check if alarm A has triggered
+  * @brief  Check if alarm has triggered
   */
-bool rtc_is_alarm_a_triggered(void) {
-    return (RTC->ISR & RTC_ISR_ALRAF) != 0;
+bool rtc_is_alarm_triggered(rtc_alarm_id_t id) {
+    return (RTC->ISR & rtc_alarm_flag_bit(id)) != 0;
 }
 
 /**
-  * @brief  Clear alarm A trigger flag
+  * @brief  Clear alarm trigger flag
   */
-void rtc_clear_alarm_a(void) {
+void rtc_clear_alarm(rtc_alarm_id_t id) {
     rtc_write_protection_disable();
-    RTC->ISR &= ~RTC_ISR_ALRAF;
+    RTC_ISR_CLEAR_FLAG(rtc_alarm_flag_bit(id));
     rtc_write_protection_enable();
 }
 
+/**
+  * @brief  Get fire-time jitter of an alarm
+  */
+void rtc_alarm_get_jitter(rtc_alarm_id_t id, rtc_alarm_jitter_t* jitter) {
+    if (jitter == NULL || id > RTC_ALARM_B) return;
+
+    bool irq_enabled = NVIC_GetEnableIRQ(RTC_ALARM_IRQn) != 0;
+    NVIC_DisableIRQ(RTC_ALARM_IRQn);
+    *jitter = alarm_jitter[id];
+    if (irq_enabled) NVIC_EnableIRQ(RTC_ALARM_IRQn);
+}
+
+/* Alarm A wrappers --------------------------------------------------------*/
+
+bool rtc_set_alarm_a(const rtc_alarm_t* alarm) {
+    return rtc_set_alarm(RTC_ALARM_A, alarm);
+}
+
+void rtc_alarm_a_enable(void) {
+    rtc_alarm_enable(RTC_ALARM_A);
+}
+
+void rtc_alarm_a_disable(void) {
+    rtc_alarm_disable(RTC_ALARM_A);
+}
+
+bool rtc_is_alarm_a_triggered(void) {
+    return rtc_is_alarm_triggered(RTC_ALARM_A);
+}
+
+void rtc_clear_alarm_a(void) {
+    rtc_clear_alarm(RTC_ALARM_A);
+}
+
+/**
+  * @brief  Record delay between programmed match and ISR entry
+  * @param  ssr: SSR sampled at ISR entry
+  * @note   Only the compared SS bits repeat, so the delay is taken
+  *         modulo that period (the full second when MASKSS = 0).
+  */
+static void rtc_alarm_record_jitter(rtc_alarm_id_t id, uint32_t ssr) {
+    uint32_t period = RTC_SYNC_PRESCALER + 1U;
+    uint8_t maskss = alarm_programmed_maskss[id];
+
+    if (maskss != 0 && maskss < 15 && (1UL << maskss) < period) {
+        period = 1UL << maskss;
+    }
+
+    /* SS counts down: elapsed = programmed - actual */
+    uint32_t elapsed = (alarm_programmed_ss[id] + period - (ssr % period)) % period;
+    uint32_t us = (elapsed * 1000000U) / (RTC_SYNC_PRESCALER + 1U);
+
+    alarm_jitter[id].last_us = us;
+    if (us > alarm_jitter[id].max_us) {
+        alarm_jitter[id].max_us = us;
+    }
+    alarm_jitter[id].count++;
+}
+
 /**
   * @brief  RTC Alarm interrupt handler
   */
 void rtc_alarm_irq_handler(void) {
+    /* Sample SSR first - it is the jitter reference */
+    uint32_t ssr = RTC->SSR & 0xFFFFU;
+    (void)RTC->DR;  /* Unlock shadow registers frozen by the SSR read */
+
+    /* Clear EXTI pending bit first (important!) */
+    EXTI->PR = (1U << RTC_ALARM_EXTI_LINE);
+
     /* Check if alarm A triggered */
     if (RTC->ISR & RTC_ISR_ALRAF) {
-        /* Clear EXTI pending bit first (important!) */
-        EXTI->PR = (1U << RTC_ALARM_EXTI_LINE);
-
-        /* Clear RTC alarm flag */
-        rtc_clear_alarm_a();
+        rtc_clear_alarm(RTC_ALARM_A);
+        rtc_alarm_record_jitter(RTC_ALARM_A, ssr);
 
         /* Call application callback */
         rtc_alarm_callback();
     }
+
+    /* Check if alarm B triggered */
+    if (RTC->ISR & RTC_ISR_ALRBF) {
+        rtc_clear_alarm(RTC_ALARM_B);
+        rtc_alarm_record_jitter(RTC_ALARM_B, ssr);
+
+        rtc_alarm_b_callback();
+    }
 }
 
 /**
@@ -689,6 +834,14 @@ __attribute__((weak)) void rtc_alarm_callback(void) {
        Override this in your application */
 }
 
+/**
+  * @brief  Default alarm B callback (weak)
+  */
+__attribute__((weak)) void rtc_alarm_b_callback(void) {
+    /* Default implementation - do nothing
+       Override this in your application */
+}
+
 #endif /* RTC_ALARM_ENABLE */
 
 /* Add these functions to your existing rtc.c file */
@@ -699,15 +852,57 @@ __attribute__((weak)) void rtc_alarm_callback(void) {
 static rtc_wakeup_config_t current_wakeup_config = {
     .rate = RTC_PERIODIC_DISABLED,
     .custom_interval = 0,
+    .custom_interval_ms = 0,
     .clock_source = RTC_WAKEUP_CLOCK_CK_SPRE_17BITS,
     .enabled = false
 };
 
+/* Wakeup dispatcher entry */
+typedef struct {
+    rtc_wakeup_handler_t handler;   /* NULL = free slot */
+    uint32_t period_ms;
+    uint32_t phase_ms;
+    uint32_t divisor;               /* Period in base ticks */
+    uint32_t countdown;             /* Base ticks until next call (0 = new entry) */
+} rtc_wakeup_subscriber_t;
+
+static rtc_wakeup_subscriber_t wakeup_subscribers[RTC_WAKEUP_MAX_SUBSCRIBERS];
+static uint32_t wakeup_base_ms = 0;
+
+/* Phase alignment: first tick is shortened, ISR restores the full reload */
+static volatile bool wakeup_align_pending = false;
+static uint32_t wakeup_steady_reload = 0;
+
+/* Tick accounting across rate switches */
+#define RTC_SUBTICKS_PER_DAY    (86400U * (RTC_SYNC_PRESCALER + 1U))
+
+static rtc_wakeup_stats_t wakeup_stats = {0};
+static uint32_t wakeup_last_stamp = 0;        /* 1/(PREDIV_S+1) s since midnight */
+static uint32_t wakeup_expected_subticks = 0; /* Interval in the same unit */
+static volatile bool wakeup_resync = true;     /* Skip miss check on next tick */
+static volatile bool wakeup_merged_tick = false; /* Old-rate tick taken over by a switch */
+static volatile uint32_t wakeup_triggered = 0;   /* Subscribers to run now (bit = slot) */
+
 /* Private function prototypes */
 static void rtc_wakeup_exti_config(void);
 static void rtc_wakeup_nvic_config(void);
 static bool rtc_wait_for_wakeup_write(uint32_t timeout);
-static uint32_t rtc_calculate_wakeup_reload(rtc_periodic_rate_t rate, uint16_t custom_interval);
+static uint32_t rtc_periodic_rate_to_ms(rtc_periodic_rate_t rate, uint16_t custom_interval,
+                                        uint32_t custom_interval_ms);
+static uint32_t rtc_calculate_wakeup_reload(uint32_t interval_ms, rtc_wakeup_clock_t* clock);
+static bool rtc_wakeup_program(uint32_t interval_ms);
+static uint32_t rtc_gcd(uint32_t a, uint32_t b);
+static bool rtc_wakeup_interval_exact(uint32_t interval_ms);
+static bool rtc_wakeup_pick_base(uint32_t* base);
+static bool rtc_wakeup_reschedule(void);
+static void rtc_wakeup_dispatch(void);
+static void rtc_wakeup_run_triggered(void);
+static bool rtc_wakeup_load_reload(uint32_t reload_value);
+static uint32_t rtc_wakeup_phase_reload(uint32_t interval_ms, rtc_wakeup_clock_t clock,
+                                        uint32_t reload_value);
+static bool rtc_wakeup_switch(uint32_t interval_ms);
+static uint32_t rtc_wakeup_timestamp(void);
+static uint32_t rtc_wakeup_expected_subticks(uint32_t interval_ms);
 
 /**
   * @brief  Initialize periodic interrupts with default rate
@@ -718,6 +913,7 @@ bool rtc_periodic_init(rtc_periodic_rate_t rate) {
     rtc_wakeup_config_t config = {
         .rate = rate,
         .custom_interval = 0,
+        .custom_interval_ms = 0,
         .clock_source = RTC_WAKEUP_CLOCK_SOURCE,
         .enabled = true
     };
@@ -729,6 +925,8 @@ bool rtc_periodic_init(rtc_periodic_rate_t rate) {
   * @brief  Initialize periodic interrupts with custom configuration
   * @param  config: Pointer to wakeup configuration structure
   * @retval true: Success, false: Failure
+  * @note   The wakeup clock is chosen from the interval, config->clock_source
+  *         is ignored and the selected clock is reported back in the saved config
   */
 bool rtc_periodic_init_custom(const rtc_wakeup_config_t* config) {
     if (config == NULL) {
@@ -743,31 +941,21 @@ bool rtc_periodic_init_custom(const rtc_wakeup_config_t* config) {
     /* Save configuration */
     current_wakeup_config = *config;
 
-    /* Disable write protection */
-    rtc_write_protection_disable();
-
-    /* Disable wakeup timer first */
-    RTC->CR &= ~RTC_CR_WUTE;
-
-    /* Wait for wakeup timer write access */
-    if (!rtc_wait_for_wakeup_write(RTC_WAKEUP_WRITE_TIMEOUT)) {
-        rtc_write_protection_enable();
+    /* Program reload value and wakeup clock (leaves WUTE cleared) */
+    uint32_t interval_ms = rtc_periodic_rate_to_ms(config->rate, config->custom_interval,
+                                                   config->custom_interval_ms);
+    if (!rtc_wakeup_program(interval_ms)) {
         return false;
     }
 
-    /* Calculate and set wakeup reload value */
-    uint32_t reload_value = rtc_calculate_wakeup_reload(config->rate, config->custom_interval);
-    RTC->WUTR = reload_value;
-
-    /* Configure wakeup clock source */
-    RTC->CR &= ~RTC_CR_WUCKSEL;  /* Clear bits */
-    RTC->CR |= config->clock_source;
+    /* Disable write protection */
+    rtc_write_protection_disable();
 
     /* Enable wakeup timer interrupt */
     RTC->CR |= RTC_CR_WUTIE;
 
     /* Clear any pending wakeup flag */
-    RTC->ISR &= ~RTC_ISR_WUTF;
+    RTC_ISR_CLEAR_FLAG(RTC_ISR_WUTF);
 
     /* Re-enable write protection */
     rtc_write_protection_enable();
@@ -809,56 +997,115 @@ void rtc_periodic_disable(void) {
 /**
   * @brief  Set new periodic rate
   * @param  rate: New interrupt rate
+  * @retval true: Success, false: Write access timeout (previous rate kept)
+  * @note   See rtc_periodic_set_interval_ms() for switching behaviour
   */
-void rtc_periodic_set_rate(rtc_periodic_rate_t rate) {
+bool rtc_periodic_set_rate(rtc_periodic_rate_t rate) {
+    if (rate == RTC_PERIODIC_DISABLED) {
+        current_wakeup_config.rate = rate;
+        rtc_periodic_disable();
+        return true;
+    }
+
+    rtc_wakeup_config_t previous = current_wakeup_config;
+
     current_wakeup_config.rate = rate;
     current_wakeup_config.custom_interval = 0;
+    current_wakeup_config.custom_interval_ms = 0;
 
-    rtc_periodic_disable();
+    if (!rtc_wakeup_switch(rtc_periodic_rate_to_ms(rate, 0, 0))) {
+        current_wakeup_config = previous;
+        return false;
+    }
 
-    /* Reconfigure with new rate */
-    rtc_write_protection_disable();
+    return true;
+}
 
-    /* Wait for write access */
-    rtc_wait_for_wakeup_write(RTC_WAKEUP_WRITE_TIMEOUT);
+/**
+  * @brief  Set custom interval for periodic interrupts
+  * @param  seconds: Interval in seconds (1-65535)
+  * @retval true: Success, false: Invalid interval or write access timeout
+  */
+bool rtc_periodic_set_custom_interval(uint16_t seconds) {
+    if (seconds == 0) return false;
 
-    /* Calculate and set new reload value */
-    uint32_t reload_value = rtc_calculate_wakeup_reload(rate, 0);
-    RTC->WUTR = reload_value;
+    rtc_wakeup_config_t previous = current_wakeup_config;
 
-    rtc_write_protection_enable();
+    current_wakeup_config.rate = RTC_PERIODIC_EVERY_CUSTOM;
+    current_wakeup_config.custom_interval = seconds;
+    current_wakeup_config.custom_interval_ms = 0;
 
-    /* Re-enable if not disabled */
-    if (rate != RTC_PERIODIC_DISABLED) {
-        rtc_periodic_enable();
+    if (!rtc_wakeup_switch((uint32_t)seconds * 1000U)) {
+        current_wakeup_config = previous;
+        return false;
     }
+
+    return true;
 }
 
 /**
-  * @brief  Set custom interval for periodic interrupts
-  * @param  seconds: Interval in seconds (1-65535)
+  * @brief  Set periodic interval with millisecond granularity
+  * @param  interval_ms: Interval in milliseconds (1 ms - 65535 s)
+  * @retval true: Success, false: Invalid interval or write access timeout
+  * @note   Sub-second intervals run from RTCCLK/2..16, so they keep
+  *         working in Stop mode without SysTick.
+  * @note   The switch is glitch-free: a tick already pending is delivered
+  *         (counted as merged), and the first tick of the new interval lands
+  *         on the next second boundary (SSR based) or, for whole-second
+  *         intervals, on the next calendar multiple of the interval.
+  *         On failure the old interval keeps running.
   */
-void rtc_periodic_set_custom_interval(uint16_t seconds) {
-    if (seconds == 0 || seconds > 65535) return;
+bool rtc_periodic_set_interval_ms(uint32_t interval_ms) {
+    if (interval_ms == 0) return false;
 
-    current_wakeup_config.rate = RTC_PERIODIC_EVERY_CUSTOM;
-    current_wakeup_config.custom_interval = seconds;
+    rtc_wakeup_config_t previous = current_wakeup_config;
 
-    rtc_periodic_disable();
+    current_wakeup_config.rate = RTC_PERIODIC_EVERY_CUSTOM_MS;
+    current_wakeup_config.custom_interval = 0;
+    current_wakeup_config.custom_interval_ms = interval_ms;
 
-    /* Reconfigure with new interval */
-    rtc_write_protection_disable();
+    if (!rtc_wakeup_switch(interval_ms)) {
+        current_wakeup_config = previous;
+        return false;
+    }
 
-    /* Wait for write access */
-    rtc_wait_for_wakeup_write(RTC_WAKEUP_WRITE_TIMEOUT);
+    return true;
+}
 
-    /* Set custom reload value (subtract 1 because 0 means 1 second) */
-    RTC->WUTR = seconds - 1;
+/**
+  * @brief  Get wakeup tick and rate-switch counters
+  * @param  stats: Pointer to statistics structure (output)
+  */
+void rtc_wakeup_get_stats(rtc_wakeup_stats_t* stats) {
+    if (stats == NULL) return;
 
-    rtc_write_protection_enable();
+    NVIC_DisableIRQ(RTC_WKUP_IRQn);
+    *stats = wakeup_stats;
+    NVIC_EnableIRQ(RTC_WKUP_IRQn);
+}
 
-    /* Re-enable */
-    rtc_periodic_enable();
+/**
+  * @brief  Reset wakeup counters
+  */
+void rtc_wakeup_reset_stats(void) {
+    NVIC_DisableIRQ(RTC_WKUP_IRQn);
+    memset(&wakeup_stats, 0, sizeof(wakeup_stats));
+    wakeup_resync = true;
+    NVIC_EnableIRQ(RTC_WKUP_IRQn);
+}
+
+/**
+  * @brief  Get the currently configured periodic interval
+  * @retval Interval in milliseconds (0 when disabled)
+  */
+uint32_t rtc_periodic_get_interval_ms(void) {
+    if (current_wakeup_config.rate == RTC_PERIODIC_DISABLED) {
+        return 0;
+    }
+
+    return rtc_periodic_rate_to_ms(current_wakeup_config.rate,
+                                   current_wakeup_config.custom_interval,
+                                   current_wakeup_config.custom_interval_ms);
 }
 
 /**
@@ -874,51 +1121,513 @@ bool rtc_is_periodic_triggered(void) {
   */
 void rtc_clear_periodic_flag(void) {
     rtc_write_protection_disable();
-    RTC->ISR &= ~RTC_ISR_WUTF;
+    RTC_ISR_CLEAR_FLAG(RTC_ISR_WUTF);
     rtc_write_protection_enable();
 }
 
 /**
-  * @brief  Calculate wakeup reload value based on rate
+  * @brief  Convert a periodic rate into its interval in milliseconds
   */
-static uint32_t rtc_calculate_wakeup_reload(rtc_periodic_rate_t rate, uint16_t custom_interval) {
-    uint32_t reload_value = 0;
-
+static uint32_t rtc_periodic_rate_to_ms(rtc_periodic_rate_t rate, uint16_t custom_interval,
+                                        uint32_t custom_interval_ms) {
     switch (rate) {
-        case RTC_PERIODIC_DISABLED:
-            reload_value = 0;
-            break;
+        case RTC_PERIODIC_EVERY_100MS:      return 100;
+        case RTC_PERIODIC_EVERY_250MS:      return 250;
+        case RTC_PERIODIC_EVERY_500MS:      return 500;
+        case RTC_PERIODIC_EVERY_SECOND:     return 1000;
+        case RTC_PERIODIC_EVERY_10_SECONDS: return 10000;
+        case RTC_PERIODIC_EVERY_30_SECONDS: return 30000;
+        case RTC_PERIODIC_EVERY_MINUTE:     return 60000;
+        case RTC_PERIODIC_EVERY_HOUR:       return 3600000;
 
-        case RTC_PERIODIC_EVERY_SECOND:
-            reload_value = 0;  /* 0 means 1 second with 1Hz clock */
-            break;
+        case RTC_PERIODIC_EVERY_CUSTOM:
+            return (custom_interval > 0) ? (uint32_t)custom_interval * 1000U : 1000U;
 
-        case RTC_PERIODIC_EVERY_10_SECONDS:
-            reload_value = 9;  /* 10 seconds (0-9 = 10 periods) */
-            break;
+        case RTC_PERIODIC_EVERY_CUSTOM_MS:
+            return (custom_interval_ms > 0) ? custom_interval_ms : 1000U;
 
-        case RTC_PERIODIC_EVERY_30_SECONDS:
-            reload_value = 29; /* 30 seconds */
-            break;
+        default:
+            return 1000;  /* Default to 1 second */
+    }
+}
 
-        case RTC_PERIODIC_EVERY_MINUTE:
-            reload_value = 59; /* 60 seconds */
-            break;
+/**
+  * @brief  Calculate wakeup clock and reload value for an interval
+  * @param  interval_ms: Wakeup period in milliseconds
+  * @param  clock: Selected wakeup clock (output)
+  * @retval Reload value for WUTR
+  * @note   Whole seconds (and anything above 32 s) use the 1 Hz ck_spre so
+  *         ticks stay on the calendar second edge. Otherwise the finest
+  *         RTCCLK divider whose 16-bit counter still spans the interval wins.
+  */
+static uint32_t rtc_calculate_wakeup_reload(uint32_t interval_ms, rtc_wakeup_clock_t* clock) {
+    static const struct {
+        rtc_wakeup_clock_t clock;
+        uint32_t hz;
+    } dividers[] = {
+        { RTC_WAKEUP_CLOCK_RTCCLK_DIV2,  RTC_CLOCK_HZ / 2U  },
+        { RTC_WAKEUP_CLOCK_RTCCLK_DIV4,  RTC_CLOCK_HZ / 4U  },
+        { RTC_WAKEUP_CLOCK_RTCCLK_DIV8,  RTC_CLOCK_HZ / 8U  },
+        { RTC_WAKEUP_CLOCK_RTCCLK_DIV16, RTC_CLOCK_HZ / 16U },
+    };
 
-        case RTC_PERIODIC_EVERY_HOUR:
-            reload_value = 3599; /* 3600 seconds (1 hour) */
-            break;
+    if ((interval_ms % 1000U) != 0 && interval_ms <= RTC_WAKEUP_MAX_SUBSECOND_MS) {
+        for (uint8_t i = 0; i < sizeof(dividers) / sizeof(dividers[0]); i++) {
+            /* 65536 periods is the longest a 16-bit reload can count */
+            if (interval_ms > (65536U * 1000U) / dividers[i].hz) {
+                continue;
+            }
 
-        case RTC_PERIODIC_EVERY_CUSTOM:
-            reload_value = (custom_interval > 0) ? (custom_interval - 1) : 0;
-            break;
+            uint32_t ticks = (interval_ms * dividers[i].hz + 500U) / 1000U;
+            *clock = dividers[i].clock;
+            return (ticks > 0) ? (ticks - 1U) : 0;
+        }
+    }
 
-        default:
-            reload_value = 0;  /* Default to 1 second */
+    /* ck_spre: reload counts whole seconds (0 means 1 second) */
+    uint32_t seconds = (interval_ms + 500U) / 1000U;
+    if (seconds == 0) seconds = 1;
+    if (seconds > 65536U) seconds = 65536U;
+
+    *clock = RTC_WAKEUP_CLOCK_CK_SPRE_16BITS;
+    return seconds - 1U;
+}
+
+/**
+  * @brief  Program wakeup reload value and clock for an interval
+  * @param  interval_ms: Wakeup period in milliseconds
+  * @retval true: Success, false: Write access timeout
+  * @note   Leaves the wakeup timer disabled (WUTE = 0)
+  */
+static bool rtc_wakeup_program(uint32_t interval_ms) {
+    rtc_wakeup_clock_t clock;
+    uint32_t reload_value = rtc_calculate_wakeup_reload(interval_ms, &clock);
+
+    /* Disable write protection */
+    rtc_write_protection_disable();
+
+    /* Disable wakeup timer first */
+    RTC->CR &= ~RTC_CR_WUTE;
+
+    /* Wait for wakeup timer write access */
+    if (!rtc_wait_for_wakeup_write(RTC_WAKEUP_WRITE_TIMEOUT)) {
+        rtc_write_protection_enable();
+        return false;
+    }
+
+    /* Set reload value and wakeup clock source */
+    RTC->WUTR = reload_value;
+    RTC->CR &= ~RTC_CR_WUCKSEL;
+    RTC->CR |= clock;
+
+    /* Re-enable write protection */
+    rtc_write_protection_enable();
+
+    current_wakeup_config.clock_source = clock;
+
+    wakeup_steady_reload = reload_value;
+    wakeup_align_pending = false;
+    wakeup_expected_subticks = rtc_wakeup_expected_subticks(interval_ms);
+    wakeup_resync = true;
+
+    return true;
+}
+
+/**
+  * @brief  Register a handler on the shared wakeup timer
+  */
+bool rtc_wakeup_subscribe(rtc_wakeup_handler_t handler, uint32_t period_ms, uint32_t phase_ms) {
+    if (handler == NULL || period_ms == 0 || phase_ms >= period_ms) {
+        return false;
+    }
+
+    /* Reuse the handler's slot, otherwise take the first free one */
+    rtc_wakeup_subscriber_t* slot = NULL;
+    for (uint8_t i = 0; i < RTC_WAKEUP_MAX_SUBSCRIBERS; i++) {
+        if (wakeup_subscribers[i].handler == handler) {
+            slot = &wakeup_subscribers[i];
             break;
+        }
+        if (slot == NULL && wakeup_subscribers[i].handler == NULL) {
+            slot = &wakeup_subscribers[i];
+        }
+    }
+
+    if (slot == NULL) {
+        return false;
+    }
+
+    /* Keep the ISR off the table while it is modified. The first user
+       configures the wakeup timer, which leaves the IRQ enabled. */
+    bool irq_enabled = NVIC_GetEnableIRQ(RTC_WKUP_IRQn) != 0 ||
+                       (RTC->CR & RTC_CR_WUTIE) == 0;
+    NVIC_DisableIRQ(RTC_WKUP_IRQn);
+    rtc_wakeup_subscriber_t saved = *slot;
+    slot->handler = handler;
+    slot->period_ms = period_ms;
+    slot->phase_ms = phase_ms;
+    slot->countdown = 0;
+
+    /* No exact base for the new set: leave the table as it was */
+    uint32_t base;
+    bool ok = rtc_wakeup_pick_base(&base);
+    if (ok) {
+        ok = rtc_wakeup_reschedule();
+    } else {
+        *slot = saved;
+    }
+    if (irq_enabled) NVIC_EnableIRQ(RTC_WKUP_IRQn);
+
+    return ok;
+}
+
+/**
+  * @brief  Remove a handler from the wakeup dispatcher
+  */
+bool rtc_wakeup_unsubscribe(rtc_wakeup_handler_t handler) {
+    for (uint8_t i = 0; i < RTC_WAKEUP_MAX_SUBSCRIBERS; i++) {
+        if (handler != NULL && wakeup_subscribers[i].handler == handler) {
+            bool irq_enabled = NVIC_GetEnableIRQ(RTC_WKUP_IRQn) != 0;
+            NVIC_DisableIRQ(RTC_WKUP_IRQn);
+            wakeup_subscribers[i].handler = NULL;
+            rtc_wakeup_reschedule();
+            if (irq_enabled) NVIC_EnableIRQ(RTC_WKUP_IRQn);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+  * @brief  Run a subscriber from the wakeup interrupt as soon as possible
+  */
+bool rtc_wakeup_trigger(rtc_wakeup_handler_t handler) {
+    for (uint8_t i = 0; i < RTC_WAKEUP_MAX_SUBSCRIBERS; i++) {
+        if (handler != NULL && wakeup_subscribers[i].handler == handler) {
+            /* Only this ISR clears the mask: keep it out while setting */
+            bool irq_enabled = NVIC_GetEnableIRQ(RTC_WKUP_IRQn) != 0;
+            NVIC_DisableIRQ(RTC_WKUP_IRQn);
+            wakeup_triggered |= (1UL << i);
+            NVIC_SetPendingIRQ(RTC_WKUP_IRQn);
+            if (irq_enabled) NVIC_EnableIRQ(RTC_WKUP_IRQn);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+  * @brief  Get the hardware wakeup period chosen by the dispatcher
+  */
+uint32_t rtc_wakeup_get_base_ms(void) {
+    return wakeup_base_ms;
+}
+
+/**
+  * @brief  Greatest common divisor (Euclid)
+  */
+static uint32_t rtc_gcd(uint32_t a, uint32_t b) {
+    while (b != 0) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+  * @brief  Recompute base rate and per-subscriber divisors, reprogram the timer
+  * @note   Called with the wakeup IRQ masked
+  */
+/**
+  * @brief  Check that an interval is a whole number of wakeup clock ticks
+  * @note   A rounded reload makes every tick slightly long or short, so
+  *         a 1 s subscriber built from several of them drifts off the
+  *         calendar second edge
+  */
+static bool rtc_wakeup_interval_exact(uint32_t interval_ms) {
+    rtc_wakeup_clock_t clock;
+    uint32_t ticks = rtc_calculate_wakeup_reload(interval_ms, &clock) + 1U;
+
+    /* RTCCLK/16../2 are WUCKSEL 0..3; ck_spre counts seconds */
+    uint32_t hz = (clock <= RTC_WAKEUP_CLOCK_RTCCLK_DIV2) ?
+                  (RTC_CLOCK_HZ >> (4U - (uint32_t)clock)) : 1U;
+
+    return (uint64_t)ticks * 1000U == (uint64_t)interval_ms * hz;
+}
+
+/**
+  * @brief  Hardware wakeup period for the current subscribers
+  * @param  base: Period in ms, 0 when nobody is subscribed (output)
+  * @retval false: No period divides every subscriber in whole clock ticks
+  * @note   The GCD of all periods and phases, or failing that its GCD
+  *         with the shortest exact period (125 ms at 32.768 kHz RTCCLK),
+  *         which also divides everything
+  */
+static bool rtc_wakeup_pick_base(uint32_t* base) {
+    uint32_t gcd = 0;
+
+    for (uint8_t i = 0; i < RTC_WAKEUP_MAX_SUBSCRIBERS; i++) {
+        if (wakeup_subscribers[i].handler == NULL) continue;
+
+        gcd = rtc_gcd(gcd, wakeup_subscribers[i].period_ms);
+        if (wakeup_subscribers[i].phase_ms != 0) {
+            gcd = rtc_gcd(gcd, wakeup_subscribers[i].phase_ms);
+        }
+    }
+
+    if (gcd != 0 && !rtc_wakeup_interval_exact(gcd)) {
+        gcd = rtc_gcd(gcd, 1000U / rtc_gcd(1000U, RTC_CLOCK_HZ / 16U));
+        if (!rtc_wakeup_interval_exact(gcd)) {
+            return false;
+        }
+    }
+
+    *base = gcd;
+    return true;
+}
+
+static bool rtc_wakeup_reschedule(void) {
+    uint32_t old_base = wakeup_base_ms;
+    uint32_t base;
+
+    if (!rtc_wakeup_pick_base(&base)) {
+        return false;
+    }
+
+    wakeup_base_ms = base;
+
+    /* Nobody listening - stop waking up */
+    if (base == 0) {
+        rtc_periodic_disable();
+        return true;
+    }
+
+    /* Only a new entry starts its schedule; the others keep their time
+       to the next call, converted to the new base (rounded up) */
+    for (uint8_t i = 0; i < RTC_WAKEUP_MAX_SUBSCRIBERS; i++) {
+        rtc_wakeup_subscriber_t* sub = &wakeup_subscribers[i];
+        if (sub->handler == NULL) continue;
+
+        sub->divisor = sub->period_ms / base;
+
+        if (sub->countdown == 0 || old_base == 0) {
+            sub->countdown = (sub->phase_ms != 0) ? (sub->phase_ms / base) : sub->divisor;
+        } else if (old_base != base) {
+            sub->countdown = (sub->countdown * old_base + base - 1U) / base;
+        }
+    }
+
+    if (base == rtc_periodic_get_interval_ms() && current_wakeup_config.enabled) {
+        return true;
+    }
+
+    /* First user of the wakeup timer also needs EXTI/NVIC set up */
+    if ((RTC->CR & RTC_CR_WUTIE) == 0) {
+        rtc_wakeup_config_t config = {
+            .rate = RTC_PERIODIC_EVERY_CUSTOM_MS,
+            .custom_interval = 0,
+            .custom_interval_ms = base,
+            .clock_source = RTC_WAKEUP_CLOCK_SOURCE,
+            .enabled = false
+        };
+        if (!rtc_periodic_init_custom(&config)) {
+            return false;
+        }
+    }
+
+    return rtc_periodic_set_interval_ms(base);
+}
+
+/**
+  * @brief  Reload the wakeup counter keeping the current clock selection
+  * @param  reload_value: New WUTR value
+  * @retval true: Success, false: Write access timeout
+  * @note   The wakeup timer is re-enabled afterwards
+  */
+static bool rtc_wakeup_load_reload(uint32_t reload_value) {
+    rtc_write_protection_disable();
+
+    RTC->CR &= ~RTC_CR_WUTE;
+    if (!rtc_wait_for_wakeup_write(RTC_WAKEUP_WRITE_TIMEOUT)) {
+        rtc_write_protection_enable();
+        return false;
     }
 
-    return reload_value;
+    RTC->WUTR = reload_value;
+    RTC->CR |= RTC_CR_WUTE;
+
+    rtc_write_protection_enable();
+    return true;
+}
+
+/**
+  * @brief  First reload value that puts the new schedule on a phase boundary
+  * @param  interval_ms: New wakeup interval
+  * @param  clock: Wakeup clock selected for the interval
+  * @param  reload_value: Steady-state reload for the interval
+  * @retval Reload for the first period only
+  * @note   RTCCLK/n intervals start on the next second edge, computed from
+  *         SSR (resolution one ck_apre period). ck_spre intervals already
+  *         count on the second edge; above 1 s they are also aligned to the
+  *         calendar, e.g. a 60 s interval then fires at hh:mm:00.
+  */
+static uint32_t rtc_wakeup_phase_reload(uint32_t interval_ms, rtc_wakeup_clock_t clock,
+                                        uint32_t reload_value) {
+    if (clock <= RTC_WAKEUP_CLOCK_RTCCLK_DIV2) {
+        /* SSR counts ck_apre periods down to the next second increment */
+        uint32_t apre_left = (RTC->SSR & 0xFFFFU) + 1U;
+        uint32_t divider = 16U >> clock;
+        uint32_t ticks = apre_left * (RTC_ASYNC_PRESCALER + 1U) / divider;
+
+        return (ticks > 0) ? (ticks - 1U) : reload_value;
+    }
+
+    if (interval_ms <= 1000U || (interval_ms % 1000U) != 0) {
+        return reload_value;
+    }
+
+    rtc_time_t now;
+    rtc_get_time(&now);
+
+    uint32_t period_s = interval_ms / 1000U;
+    uint32_t second_of_day = (uint32_t)now.hours * 3600U +
+                             (uint32_t)now.minutes * 60U + now.seconds;
+
+    return (period_s - (second_of_day % period_s)) - 1U;
+}
+
+/**
+  * @brief  Switch the running wakeup timer to a new interval
+  * @param  interval_ms: New wakeup interval
+  * @retval true: Success, false: Write access timeout (old interval kept running)
+  * @note   A tick already due is not lost: its flag is cleared here and
+  *         the ISR is pended to dispatch it on its own path, which leaves
+  *         the phase alignment of the new schedule untouched.
+  */
+static bool rtc_wakeup_switch(uint32_t interval_ms) {
+    rtc_wakeup_clock_t clock;
+    uint32_t reload_value = rtc_calculate_wakeup_reload(interval_ms, &clock);
+
+    /* Calendar read (if any) happens before the timer is touched */
+    uint32_t first_reload = rtc_wakeup_phase_reload(interval_ms, clock, reload_value);
+
+    /* The ISR must not restore a stale reload in the middle of the switch */
+    bool irq_enabled = NVIC_GetEnableIRQ(RTC_WKUP_IRQn) != 0;
+    NVIC_DisableIRQ(RTC_WKUP_IRQn);
+
+    rtc_write_protection_disable();
+
+    uint32_t was_running = RTC->CR & RTC_CR_WUTE;
+    RTC->CR &= ~RTC_CR_WUTE;
+
+    if (!rtc_wait_for_wakeup_write(RTC_WAKEUP_WRITE_TIMEOUT)) {
+        /* Keep the old schedule alive */
+        RTC->CR |= was_running;
+        rtc_write_protection_enable();
+
+        wakeup_stats.switch_failures++;
+        if (irq_enabled) NVIC_EnableIRQ(RTC_WKUP_IRQn);
+        return false;
+    }
+
+    /* A pending old-rate tick is merged into the switch, not dropped.
+       Its flag must not reach the ISR as a new-rate tick: that would end
+       the alignment period early. */
+    bool merged = (RTC->ISR & RTC_ISR_WUTF) != 0;
+    if (merged) {
+        RTC_ISR_CLEAR_FLAG(RTC_ISR_WUTF);
+        EXTI->PR = (1U << RTC_WAKEUP_EXTI_LINE);
+        wakeup_stats.merged_ticks++;
+    }
+
+    /* Recompute the phase right before restarting (SSR moves at 256 Hz) */
+    if (clock <= RTC_WAKEUP_CLOCK_RTCCLK_DIV2) {
+        first_reload = rtc_wakeup_phase_reload(interval_ms, clock, reload_value);
+    }
+
+    RTC->WUTR = first_reload;
+    RTC->CR &= ~RTC_CR_WUCKSEL;
+    RTC->CR |= clock | RTC_CR_WUTE;
+
+    rtc_write_protection_enable();
+
+    wakeup_steady_reload = reload_value;
+    wakeup_align_pending = (first_reload != reload_value);
+    wakeup_expected_subticks = rtc_wakeup_expected_subticks(interval_ms);
+    wakeup_resync = true;
+    wakeup_stats.rate_changes++;
+
+    current_wakeup_config.clock_source = clock;
+    current_wakeup_config.enabled = true;
+
+    if (merged) {
+        wakeup_merged_tick = true;
+        NVIC_SetPendingIRQ(RTC_WKUP_IRQn);
+    }
+
+    if (irq_enabled) NVIC_EnableIRQ(RTC_WKUP_IRQn);
+    return true;
+}
+
+/**
+  * @brief  Calendar timestamp for tick accounting
+  * @retval 1/(PREDIV_S+1) s units since midnight
+  */
+static uint32_t rtc_wakeup_timestamp(void) {
+    /* SSR first: it freezes TR/DR shadows until DR is read */
+    uint32_t ssr = RTC->SSR & 0xFFFFU;
+    uint32_t tr = RTC->TR;
+    (void)RTC->DR;
+
+    uint32_t second_of_day = (uint32_t)bcd_to_bin((tr >> 16) & 0x3F) * 3600U +
+                             (uint32_t)bcd_to_bin((tr >> 8) & 0x7F) * 60U +
+                             bcd_to_bin(tr & 0x7F);
+
+    return second_of_day * (RTC_SYNC_PRESCALER + 1U) + (RTC_SYNC_PRESCALER - ssr);
+}
+
+/**
+  * @brief  Interval in timestamp units for miss detection
+  * @retval 1/(PREDIV_S+1) s units, or 0 to skip the check
+  * @note   Gaps are measured modulo one day, so misses can only be seen
+  *         while two intervals fit in a day.
+  */
+static uint32_t rtc_wakeup_expected_subticks(uint32_t interval_ms) {
+    uint64_t subticks = ((uint64_t)interval_ms * (RTC_SYNC_PRESCALER + 1U)) / 1000U;
+
+    return (subticks * 2U < RTC_SUBTICKS_PER_DAY) ? (uint32_t)subticks : 0;
+}
+
+/**
+  * @brief  Run every subscriber whose divisor expired on this base tick
+  */
+static void rtc_wakeup_dispatch(void) {
+    for (uint8_t i = 0; i < RTC_WAKEUP_MAX_SUBSCRIBERS; i++) {
+        rtc_wakeup_subscriber_t* sub = &wakeup_subscribers[i];
+        if (sub->handler == NULL) continue;
+
+        if (--sub->countdown == 0) {
+            sub->countdown = sub->divisor;
+            sub->handler();
+        }
+    }
+}
+
+/**
+  * @brief  Run the subscribers pended by rtc_wakeup_trigger
+  */
+static void rtc_wakeup_run_triggered(void) {
+    uint32_t mask = wakeup_triggered;
+    wakeup_triggered = 0;
+
+    for (uint8_t i = 0; i < RTC_WAKEUP_MAX_SUBSCRIBERS; i++) {
+        if ((mask & (1UL << i)) != 0 && wakeup_subscribers[i].handler != NULL) {
+            wakeup_subscribers[i].handler();
+        }
+    }
 }
 
 /**
@@ -962,6 +1671,20 @@ static void rtc_wakeup_nvic_config(void) {
   * @brief  RTC Wakeup interrupt handler (call this from IRQ handler)
   */
 void rtc_wakeup_irq_handler(void) {
+    /* Old-rate tick merged into a rate switch: deliver it, but leave
+       alignment and miss accounting to the new schedule's ticks */
+    if (wakeup_merged_tick) {
+        wakeup_merged_tick = false;
+        wakeup_stats.ticks++;
+        rtc_wakeup_dispatch();
+        rtc_periodic_callback();
+    }
+
+    /* Subscribers the main loop asked to run now */
+    if (wakeup_triggered != 0) {
+        rtc_wakeup_run_triggered();
+    }
+
     /* Check if wakeup timer triggered */
     if (RTC->ISR & RTC_ISR_WUTF) {
         /* Clear EXTI pending bit first */
@@ -970,7 +1693,30 @@ void rtc_wakeup_irq_handler(void) {
         /* Clear RTC wakeup flag */
         rtc_clear_periodic_flag();
 
-        /* Call application callback for LCD update */
+        /* First aligned tick done - back to the full interval */
+        if (wakeup_align_pending) {
+            wakeup_align_pending = false;
+            rtc_wakeup_load_reload(wakeup_steady_reload);
+        }
+
+        /* A gap of several intervals means the flag was set more than once */
+        uint32_t now = rtc_wakeup_timestamp();
+        if (!wakeup_resync && wakeup_expected_subticks > 0) {
+            uint32_t elapsed = (now + RTC_SUBTICKS_PER_DAY - wakeup_last_stamp) % RTC_SUBTICKS_PER_DAY;
+            uint32_t expected = wakeup_expected_subticks;
+
+            if (elapsed > expected + expected / 2U) {
+                wakeup_stats.missed_ticks += (elapsed + expected / 2U) / expected - 1U;
+            }
+        }
+        wakeup_resync = false;
+        wakeup_last_stamp = now;
+        wakeup_stats.ticks++;
+
+        /* Fan out to subscribers */
+        rtc_wakeup_dispatch();
+
+        /* Legacy callback still runs on every hardware tick */
         rtc_periodic_callback();
     }
 }
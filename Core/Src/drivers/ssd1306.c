@@ -0,0 +1,362 @@
+/**
+  ******************************************************************************
+  * @file    ssd1306.c
+  * @brief   SSD1306 128x64 OLED driver (I2C, DMA page flushes).
+  * @note    Drawing goes into a 1 KB framebuffer. Each page keeps the
+  *          column span whose bytes actually changed; the flush sends one
+  *          span per DMA transfer, preceded by a column/page window, so an
+  *          unchanged screen costs nothing and a seconds tick costs only the
+  *          columns of the digits that changed.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ssd1306.h"
+#include "i2c.h"
+#include "board_config.h"
+#include <stddef.h>
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define CTRL_COMMANDS       0x00    /* Control byte: command stream */
+#define CTRL_DATA           0x40    /* Control byte: GDDRAM data */
+#define SPAN_CLEAN          0xFF    /* dirty_x0 of a page with nothing to send */
+#define INIT_TIMEOUT        100000
+#define BIG_SCALE           3
+#define BIG_GLYPHS          12      /* '0'-'9', ':', ' ' */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {
+    FLUSH_IDLE = 0,
+    FLUSH_WINDOW,               /*!< Window command in flight */
+    FLUSH_DATA                  /*!< Pixel data in flight */
+} flush_stage_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+/* 5x7 font, column bytes (bit 0 = top row): '-' to ':' then 'A' to 'Z' */
+static const uint8_t font5x7[][SSD1306_FONT_W] = {
+    { 0x08, 0x08, 0x08, 0x08, 0x08 },   /* '-' */
+    { 0x00, 0x60, 0x60, 0x00, 0x00 },   /* '.' */
+    { 0x20, 0x10, 0x08, 0x04, 0x02 },   /* '/' */
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E },   /* '0' */
+    { 0x00, 0x42, 0x7F, 0x40, 0x00 },   /* '1' */
+    { 0x42, 0x61, 0x51, 0x49, 0x46 },   /* '2' */
+    { 0x21, 0x41, 0x45, 0x4B, 0x31 },   /* '3' */
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 },   /* '4' */
+    { 0x27, 0x45, 0x45, 0x45, 0x39 },   /* '5' */
+    { 0x3C, 0x4A, 0x49, 0x49, 0x30 },   /* '6' */
+    { 0x01, 0x71, 0x09, 0x05, 0x03 },   /* '7' */
+    { 0x36, 0x49, 0x49, 0x49, 0x36 },   /* '8' */
+    { 0x06, 0x49, 0x49, 0x29, 0x1E },   /* '9' */
+    { 0x00, 0x36, 0x36, 0x00, 0x00 },   /* ':' */
+    { 0x7E, 0x09, 0x09, 0x09, 0x7E },   /* 'A' */
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 },   /* 'B' */
+    { 0x3E, 0x41, 0x41, 0x41, 0x22 },   /* 'C' */
+    { 0x7F, 0x41, 0x41, 0x22, 0x1C },   /* 'D' */
+    { 0x7F, 0x49, 0x49, 0x49, 0x41 },   /* 'E' */
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 },   /* 'F' */
+    { 0x3E, 0x41, 0x49, 0x49, 0x7A },   /* 'G' */
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F },   /* 'H' */
+    { 0x00, 0x41, 0x7F, 0x41, 0x00 },   /* 'I' */
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 },   /* 'J' */
+    { 0x7F, 0x08, 0x14, 0x22, 0x41 },   /* 'K' */
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 },   /* 'L' */
+    { 0x7F, 0x02, 0x0C, 0x02, 0x7F },   /* 'M' */
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F },   /* 'N' */
+    { 0x3E, 0x41, 0x41, 0x41, 0x3E },   /* 'O' */
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 },   /* 'P' */
+    { 0x3E, 0x41, 0x51, 0x21, 0x5E },   /* 'Q' */
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 },   /* 'R' */
+    { 0x46, 0x49, 0x49, 0x49, 0x31 },   /* 'S' */
+    { 0x01, 0x01, 0x7F, 0x01, 0x01 },   /* 'T' */
+    { 0x3F, 0x40, 0x40, 0x40, 0x3F },   /* 'U' */
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F },   /* 'V' */
+    { 0x3F, 0x40, 0x38, 0x40, 0x3F },   /* 'W' */
+    { 0x63, 0x14, 0x08, 0x14, 0x63 },   /* 'X' */
+    { 0x03, 0x04, 0x78, 0x04, 0x03 },   /* 'Y' */
+    { 0x61, 0x51, 0x49, 0x45, 0x43 },   /* 'Z' */
+};
+
+static uint8_t framebuffer[SSD1306_PAGES][SSD1306_WIDTH];
+static uint8_t dirty_x0[SSD1306_PAGES];
+static uint8_t dirty_x1[SSD1306_PAGES];
+
+/* Big digit atlas, built from the font at init: blits are plain copies */
+static uint8_t big_atlas[BIG_GLYPHS][SSD1306_BIG_PAGES][SSD1306_BIG_W];
+
+/* DMA sources must outlive the transfer */
+static uint8_t tx_window[7];
+static uint8_t tx_data[1 + SSD1306_WIDTH];
+
+static flush_stage_t flush_stage = FLUSH_IDLE;
+static uint8_t flush_page;
+static uint8_t flush_x0;
+static uint8_t flush_x1;
+
+static ssd1306_stats_t stats;
+
+static const uint8_t init_commands[] = {
+    CTRL_COMMANDS,
+    0xAE,               /* Display off */
+    0xD5, 0x80,         /* Clock divide / oscillator */
+    0xA8, 0x3F,         /* Multiplex 64 */
+    0xD3, 0x00,         /* No display offset */
+    0x40,               /* Start line 0 */
+    0x8D, 0x14,         /* Charge pump on */
+    0x20, 0x00,         /* Horizontal addressing: windows wrap by page */
+    0xA1,               /* Segment remap (column 127 = SEG0) */
+    0xC8,               /* COM scan descending */
+    0xDA, 0x12,         /* COM pins: alternative */
+    0x81, 0xCF,         /* Contrast */
+    0xD9, 0xF1,         /* Pre-charge */
+    0xDB, 0x40,         /* VCOMH deselect */
+    0xA4,               /* Display follows RAM */
+    0xA6,               /* Normal (not inverted) */
+    0xAF,               /* Display on */
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static void ssd1306_put(uint8_t x, uint8_t page, uint8_t value);
+static const uint8_t* ssd1306_glyph(char c);
+static void ssd1306_mark_span(uint8_t page, uint8_t x0, uint8_t x1);
+static void ssd1306_build_atlas(void);
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ssd1306_init(void) {
+    uint32_t timeout = INIT_TIMEOUT;
+
+    ssd1306_build_atlas();
+
+    if (i2c_write_dma(DISPLAY_I2C_ADDR, init_commands, sizeof(init_commands)) != I2C_OK) {
+        return false;
+    }
+    while (i2c_dma_busy()) {
+        if (timeout-- == 0) {
+            return false;
+        }
+    }
+
+    /* GDDRAM content is random after power-up: send every page once */
+    memset(framebuffer, 0, sizeof(framebuffer));
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        ssd1306_mark_span(page, 0, SSD1306_WIDTH - 1);
+    }
+    flush_stage = FLUSH_IDLE;
+
+    return i2c_get_last_error() == I2C_OK;
+}
+
+void ssd1306_clear(void) {
+    ssd1306_fill(0, 0, SSD1306_WIDTH, SSD1306_PAGES, 0x00);
+}
+
+void ssd1306_fill(uint8_t x, uint8_t page, uint8_t width, uint8_t pages, uint8_t pattern) {
+    for (uint8_t p = page; p < page + pages && p < SSD1306_PAGES; p++) {
+        for (uint16_t col = x; col < x + width && col < SSD1306_WIDTH; col++) {
+            ssd1306_put((uint8_t)col, p, pattern);
+        }
+    }
+}
+
+void ssd1306_draw_char(uint8_t x, uint8_t page, char c) {
+    const uint8_t* glyph = ssd1306_glyph(c);
+
+    for (uint8_t i = 0; i < SSD1306_FONT_W; i++) {
+        ssd1306_put(x + i, page, (glyph != NULL) ? glyph[i] : 0x00);
+    }
+    ssd1306_put(x + SSD1306_FONT_W, page, 0x00);    /* Spacing column */
+}
+
+void ssd1306_draw_text(uint8_t x, uint8_t page, const char* str) {
+    if (str == NULL) return;
+
+    while (*str != '\0' && x < SSD1306_WIDTH) {
+        ssd1306_draw_char(x, page, *str++);
+        x += SSD1306_FONT_PITCH;
+    }
+}
+
+void ssd1306_draw_big_char(uint8_t x, uint8_t page, char c) {
+    uint8_t index;
+
+    if (c >= '0' && c <= '9') {
+        index = (uint8_t)(c - '0');
+    } else if (c == ':') {
+        index = 10;
+    } else {
+        index = 11;     /* Blank */
+    }
+
+    for (uint8_t p = 0; p < SSD1306_BIG_PAGES; p++) {
+        for (uint8_t i = 0; i < SSD1306_BIG_W; i++) {
+            ssd1306_put(x + i, page + p, big_atlas[index][p][i]);
+        }
+    }
+}
+
+bool ssd1306_flush_poll(void) {
+    if (i2c_dma_busy()) {
+        return true;
+    }
+
+    if (flush_stage == FLUSH_WINDOW) {
+        /* Window is set - now the changed columns themselves */
+        uint8_t count = flush_x1 - flush_x0 + 1;
+
+        tx_data[0] = CTRL_DATA;
+        memcpy(&tx_data[1], &framebuffer[flush_page][flush_x0], count);
+
+        if (i2c_write_dma(DISPLAY_I2C_ADDR, tx_data, count + 1U) != I2C_OK) {
+            /* Bus busy or NACK: try the span again later */
+            stats.i2c_errors++;
+            ssd1306_mark_span(flush_page, flush_x0, flush_x1);
+            flush_stage = FLUSH_IDLE;
+            return true;
+        }
+
+        stats.i2c_bytes += count + 1U;
+        stats.pixel_bytes += count;
+        flush_stage = FLUSH_DATA;
+        return true;
+    }
+
+    flush_stage = FLUSH_IDLE;
+
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        if (dirty_x0[page] == SPAN_CLEAN) {
+            continue;
+        }
+
+        /* Take the span; drawing during the transfer starts a new one */
+        flush_page = page;
+        flush_x0 = dirty_x0[page];
+        flush_x1 = dirty_x1[page];
+        dirty_x0[page] = SPAN_CLEAN;
+
+        tx_window[0] = CTRL_COMMANDS;
+        tx_window[1] = 0x21;            /* Column range */
+        tx_window[2] = flush_x0;
+        tx_window[3] = flush_x1;
+        tx_window[4] = 0x22;            /* Page range */
+        tx_window[5] = page;
+        tx_window[6] = page;
+
+        if (i2c_write_dma(DISPLAY_I2C_ADDR, tx_window, sizeof(tx_window)) != I2C_OK) {
+            stats.i2c_errors++;
+            ssd1306_mark_span(page, flush_x0, flush_x1);
+            return true;
+        }
+
+        stats.i2c_bytes += sizeof(tx_window);
+        stats.flushes++;
+        flush_stage = FLUSH_WINDOW;
+        return true;
+    }
+
+    return false;
+}
+
+bool ssd1306_is_dirty(void) {
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        if (dirty_x0[page] != SPAN_CLEAN) {
+            return true;
+        }
+    }
+    return flush_stage != FLUSH_IDLE;
+}
+
+const uint8_t* ssd1306_get_framebuffer(void) {
+    return &framebuffer[0][0];
+}
+
+void ssd1306_get_stats(ssd1306_stats_t* out) {
+    if (out != NULL) {
+        *out = stats;
+    }
+}
+
+void ssd1306_reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Write one framebuffer byte, widening the page's dirty span
+  *         only if the value changes.
+  */
+static void ssd1306_put(uint8_t x, uint8_t page, uint8_t value) {
+    if (x >= SSD1306_WIDTH || page >= SSD1306_PAGES || framebuffer[page][x] == value) {
+        return;
+    }
+
+    framebuffer[page][x] = value;
+    ssd1306_mark_span(page, x, x);
+}
+
+/**
+  * @brief  Widen a page's dirty span to cover columns x0..x1.
+  */
+static void ssd1306_mark_span(uint8_t page, uint8_t x0, uint8_t x1) {
+    if (dirty_x0[page] == SPAN_CLEAN) {
+        dirty_x0[page] = x0;
+        dirty_x1[page] = x1;
+        return;
+    }
+
+    if (x0 < dirty_x0[page]) dirty_x0[page] = x0;
+    if (x1 > dirty_x1[page]) dirty_x1[page] = x1;
+}
+
+/**
+  * @brief  Font columns for a character (lower case maps to upper case).
+  * @retval Pointer to 5 column bytes, or NULL for a blank
+  */
+static const uint8_t* ssd1306_glyph(char c) {
+    if (c >= 'a' && c <= 'z') {
+        c = (char)(c - 'a' + 'A');
+    }
+
+    if (c >= '-' && c <= ':') {
+        return font5x7[c - '-'];
+    }
+    if (c >= 'A' && c <= 'Z') {
+        return font5x7[(':' - '-' + 1) + (c - 'A')];
+    }
+    return NULL;
+}
+
+/**
+  * @brief  Scale the font digits 3x into page-aligned column bytes.
+  * @note   Glyph rows 0-6 become pixel rows 1-21 of the three pages.
+  */
+static void ssd1306_build_atlas(void) {
+    static const char atlas_chars[BIG_GLYPHS] = "0123456789: ";
+
+    memset(big_atlas, 0, sizeof(big_atlas));
+
+    for (uint8_t g = 0; g < BIG_GLYPHS; g++) {
+        const uint8_t* glyph = ssd1306_glyph(atlas_chars[g]);
+        if (glyph == NULL) {
+            continue;
+        }
+
+        for (uint8_t gx = 0; gx < SSD1306_FONT_W; gx++) {
+            for (uint8_t gy = 0; gy < 7; gy++) {
+                if ((glyph[gx] & (1U << gy)) == 0) {
+                    continue;
+                }
+
+                for (uint8_t dy = 0; dy < BIG_SCALE; dy++) {
+                    uint8_t y = 1 + gy * BIG_SCALE + dy;
+
+                    for (uint8_t dx = 0; dx < BIG_SCALE; dx++) {
+                        big_atlas[g][y / 8][gx * BIG_SCALE + dx] |= (uint8_t)(1U << (y % 8));
+                    }
+                }
+            }
+        }
+    }
+}
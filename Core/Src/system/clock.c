@@ -0,0 +1,37 @@
+/**
+  ******************************************************************************
+  * @file    clock.c
+  * @brief   Bus and timer clocks derived from the current RCC configuration.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "clock.h"
+#include "stm32f4xx.h"
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t clock_timer_hz(uint32_t ppre);
+
+/* Exported functions --------------------------------------------------------*/
+
+uint32_t clock_apb1_timer_hz(void) {
+    return clock_timer_hz((RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos);
+}
+
+uint32_t clock_apb2_timer_hz(void) {
+    return clock_timer_hz((RCC->CFGR & RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos);
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Timer clock behind an APB prescaler.
+  * @param  ppre: PPREx field (0xx = /1, 100 = /2 ... 111 = /16)
+  * @retval Clock in Hz: HCLK undivided, otherwise twice the bus clock.
+  */
+static uint32_t clock_timer_hz(uint32_t ppre) {
+    if (ppre < 4U) {
+        return SystemCoreClock;                     /* APB = HCLK */
+    }
+    return (SystemCoreClock >> (ppre - 3U)) * 2U;   /* /2../16, timers x2 */
+}
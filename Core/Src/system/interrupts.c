@@ -8,6 +8,8 @@
 /* Includes ------------------------------------------------------------------*/
 #include "button.h"
 #include "rtc.h"
+#include "led_pattern.h"
+#include "i2c.h"
 
 /**
   * @brief  EXTI0 interrupt handler (PA0 button).
@@ -16,6 +18,56 @@ void EXTI0_IRQHandler(void) {
     button_exti_handler();
 }
 
+/**
+  * @brief  EXTI1-EXTI3 interrupt handlers (PA1-PA3 buttons).
+  */
+void EXTI1_IRQHandler(void) {
+    button_exti_handler();
+}
+
+void EXTI2_IRQHandler(void) {
+    button_exti_handler();
+}
+
+void EXTI3_IRQHandler(void) {
+    button_exti_handler();
+}
+
+/**
+  * @brief  TIM7 interrupt handler (button debounce timer).
+  */
+void TIM7_IRQHandler(void) {
+    button_timer_irq_handler();
+}
+
+/**
+  * @brief  TIM5 interrupt handler (button edge capture, if enabled).
+  */
+void TIM5_IRQHandler(void) {
+    button_capture_irq_handler();
+}
+
+/**
+  * @brief  DMA2 Stream1 interrupt handler (LED pattern one-shot end).
+  */
+void DMA2_Stream1_IRQHandler(void) {
+    led_pattern_dma_irq_handler();
+}
+
+/**
+  * @brief  DMA1 Stream6 interrupt handler (I2C1 TX DMA complete).
+  */
+void DMA1_Stream6_IRQHandler(void) {
+    i2c_dma_irq_handler();
+}
+
+/**
+  * @brief  I2C1 event interrupt handler (STOP after a DMA write).
+  */
+void I2C1_EV_IRQHandler(void) {
+    i2c_ev_irq_handler();
+}
+
 #if RTC_ALARM_ENABLE
 
 /**
@@ -0,0 +1,95 @@
+/**
+  ******************************************************************************
+  * @file    reset.c
+  * @brief   Reset cause detection and warm-boot marker.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "reset.h"
+#include "stm32f4xx.h"
+#include "rtc_config.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Backup registers are consecutive: BKP0R..BKP19R */
+#define BKP_REG(n)          ((&RTC->BKP0R)[(n)])
+
+/* Private variables ---------------------------------------------------------*/
+
+static reset_cause_t reset_cause = RESET_CAUSE_UNKNOWN;
+static bool display_marker_valid = false;
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Latch and clear the reset flags, read the warm-boot marker.
+  * @retval None
+  */
+void reset_init(void) {
+    uint32_t csr = RCC->CSR;
+
+    /* Every reset also pulses NRST, so PINRSTF is checked last. A POR
+       also sets BORRSTF, so POR is checked before BOR. */
+    if (csr & RCC_CSR_LPWRRSTF) {
+        reset_cause = RESET_CAUSE_LOW_POWER;
+    } else if (csr & RCC_CSR_WWDGRSTF) {
+        reset_cause = RESET_CAUSE_WWDG;
+    } else if (csr & RCC_CSR_WDGRSTF) {
+        reset_cause = RESET_CAUSE_IWDG;
+    } else if (csr & RCC_CSR_SFTRSTF) {
+        reset_cause = RESET_CAUSE_SOFTWARE;
+    } else if (csr & RCC_CSR_PORRSTF) {
+        reset_cause = RESET_CAUSE_POWER_ON;
+    } else if (csr & RCC_CSR_BORRSTF) {
+        reset_cause = RESET_CAUSE_BROWNOUT;
+    } else if (csr & RCC_CSR_PADRSTF) {
+        reset_cause = RESET_CAUSE_PIN;
+    } else {
+        reset_cause = RESET_CAUSE_UNKNOWN;
+    }
+
+    /* Clear flags so the next reset reports only itself */
+    RCC->CSR |= RCC_CSR_RMVF;
+
+    display_marker_valid = (BKP_REG(BKP_REG_DISPLAY_MARKER) == DISPLAY_READY_MAGIC);
+}
+
+/**
+  * @brief  Get the cause of the last reset.
+  * @retval Reset cause latched by reset_init().
+  */
+reset_cause_t reset_get_cause(void) {
+    return reset_cause;
+}
+
+/**
+  * @brief  Check whether the LCD survived the reset configured.
+  * @retval true: fast boot is safe, false: full LCD init required.
+  */
+bool reset_is_warm(void) {
+    switch (reset_cause) {
+        case RESET_CAUSE_POWER_ON:
+        case RESET_CAUSE_BROWNOUT:
+        case RESET_CAUSE_UNKNOWN:
+            return false;
+
+        default:
+            return display_marker_valid;
+    }
+}
+
+/**
+  * @brief  Set or clear the "LCD configured" backup-register marker.
+  * @param  valid: true to set, false to clear.
+  * @retval None
+  */
+void reset_set_display_marker(bool valid) {
+    BKP_REG(BKP_REG_DISPLAY_MARKER) = valid ? DISPLAY_READY_MAGIC : 0;
+}
@@ -57,6 +57,39 @@ typedef enum {
 
 #define LED_ALL_PINS     (LED_GREEN_PIN_MSK | LED_ORANGE_PIN_MSK | LED_RED_PIN_MSK | LED_BLUE_PIN_MSK)
 
+// LED PWM: PD12-PD15 = TIM4_CH1-CH4 (AF2), channel = led_id_t + 1
+#define LED_PWM_TIMER        TIM4
+#define LED_PWM_AF           2
+#define LED_PWM_TICK_US      100     // 10 kHz counter: 1% steps at 100 Hz, periods up to 6.5 s
+#define LED_PWM_DIM_PERIOD_US 10000  // 100 Hz - flicker-free brightness
+#define LED_PWM_CLK_ENABLE()  do {        \
+    RCC->APB1ENR |= RCC_APB1ENR_TIM4EN;   \
+} while(0)
+
+// LED pattern sequencer: TIM8 update requests DMA2 Stream1 Channel 7,
+// which writes BSRR words into GPIOD (only DMA2 reaches AHB1 GPIO)
+#define LED_PATTERN_TIMER        TIM8
+#define LED_PATTERN_TICK_US      100     // Step resolution, steps up to 6.5 s
+#define LED_PATTERN_DMA          DMA2
+#define LED_PATTERN_DMA_STREAM   DMA2_Stream1
+#define LED_PATTERN_DMA_CHANNEL  7
+#define LED_PATTERN_DMA_IRQN     DMA2_Stream1_IRQn
+#define LED_PATTERN_CLK_ENABLE()  do {    \
+    RCC->APB2ENR |= RCC_APB2ENR_TIM8EN;   \
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;   \
+} while(0)
+
+// I2C1 TX DMA: DMA1 Stream6 Channel 1 (bulk writes, e.g. SSD1306 pages).
+// One transaction per buffer; STOP is sent from I2C1_EV on BTF.
+#define I2C_TX_DMA               DMA1
+#define I2C_TX_DMA_STREAM        DMA1_Stream6
+#define I2C_TX_DMA_CHANNEL       1
+#define I2C_TX_DMA_IRQN          DMA1_Stream6_IRQn
+#define I2C_EV_IRQN              I2C1_EV_IRQn
+#define I2C_TX_DMA_CLK_ENABLE()  do {     \
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;   \
+} while(0)
+
 /* Button Configuration ------------------------------------------------------*/
 #define BUTTON_GPIO_PORT         GPIOA       /*!< PA0 - User button */
 #define BUTTON_GPIO_PIN_MSK      GPIO_PIN_0
@@ -71,8 +104,18 @@ typedef enum {
 
 
 // Display Configuration
-#define DISPLAY_TYPE        OLED_SSD1306  // Or LCD_1602, UART, etc.
+#define DISPLAY_LCD_1602      1           // HD44780 16x2 behind a PCF8574 (LCD_I2C_ADDR)
+#define DISPLAY_OLED_SSD1306  2           // SSD1306 128x64 at DISPLAY_I2C_ADDR
+#define DISPLAY_HOST_TERMINAL 3           // Headless: 16x2 window printed to stdout
+#ifndef DISPLAY_TYPE                      // Host builds pick a backend with -DDISPLAY_TYPE=
+#define DISPLAY_TYPE        DISPLAY_LCD_1602
+#endif
 #define DISPLAY_I2C_ADDR    0x3C
+#define DISPLAY_TIME_ONLY_BIG_DIGITS 1    // TIME_ONLY shows HH:MM two rows tall
+#define DISPLAY_MAX_FPS     20            // Frame scheduler rate cap
+#define DISPLAY_FRAME_I2C_BUDGET 192      // PCF8574 bytes per frame (4 per LCD byte), 0 = unlimited
+#define DISPLAY_PREPARE_GUARD_US 20000    // Skip pre-rendering this close to the second edge
+#define DISPLAY_MARQUEE_STEP_MS 250       // Scroll step (RTC wakeup subscriber period)
 
 
 
@@ -83,6 +126,8 @@ typedef enum {
 #define BUTTON_MIN_PIN      GPIO_PIN_1
 #define BUTTON_SET_PIN      GPIO_PIN_2
 #define BUTTON_ALARM_PIN    GPIO_PIN_3
+#define BUTTON_ALL_PINS     (BUTTON_HOUR_PIN | BUTTON_MIN_PIN | BUTTON_SET_PIN | BUTTON_ALARM_PIN)
+#define BUTTON_PIN_COUNT    4           /*!< PA0..PA3 = IDR bits 0..3 = button IDs */
 
 #define BUTTON_EXTI_LINE         EXTI_Line0
 #define BUTTON_IRQN              EXTI0_IRQn
@@ -90,14 +135,46 @@ typedef enum {
     RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN; \
 } while(0)
 
+/* Button debounce timer (one-shot, 10 kHz count from the APB1 timer clock) */
+#define BUTTON_TIMER             TIM7
+#define BUTTON_TIMER_IRQN        TIM7_IRQn
+#define BUTTON_TIMER_CLK_ENABLE() do { \
+    RCC->APB1ENR |= RCC_APB1ENR_TIM7EN; \
+} while(0)
+
+/* Optional hardware edge timestamps: PA0-PA3 = TIM5_CH1-CH4 (AF2), 1 MHz
+   free-running 32-bit counter. Replaces EXTI as the wake source. */
+#define BUTTON_USE_INPUT_CAPTURE 0
+#define BUTTON_CAPTURE_TIMER     TIM5
+#define BUTTON_CAPTURE_IRQN      TIM5_IRQn
+#define BUTTON_CAPTURE_AF        2
+#define BUTTON_CAPTURE_CLK_ENABLE() do { \
+    RCC->APB1ENR |= RCC_APB1ENR_TIM5EN; \
+} while(0)
+
 /* Timing Configuration ------------------------------------------------------*/
 #define DEBOUNCE_TIME_MS       50    /*!< Button de-bounce time */
 #define LONG_PRESS_TIME_MS     1000  /*!< 2 seconds for long press */
 #define DOUBLE_CLICK_MAX_MS    500   /*!< Max time between double clicks */
+#define BUTTON_SAMPLE_MS       (DEBOUNCE_TIME_MS / 4)  /*!< 4 stable samples = debounced */
+#define BUTTON_EVENT_QUEUE_SIZE 8    /*!< Button event FIFO depth (power of two) */
+
+/* Hold-to-repeat: first repeat after the delay, then the interval shrinks
+   by the step on every repeat down to the minimum. The delay is below
+   LONG_PRESS_TIME_MS, so a held repeat-enabled button repeats and never
+   long-presses: HOUR (up) and MIN (down) step while held in edit mode. */
+#define BUTTON_REPEAT_DELAY_MS     500   /*!< Hold time before the first repeat */
+#define BUTTON_REPEAT_START_MS     200   /*!< Initial repeat interval */
+#define BUTTON_REPEAT_MIN_MS       40    /*!< Fastest repeat interval */
+#define BUTTON_REPEAT_ACCEL_MS     20    /*!< Interval decrease per repeat */
+#define BUTTON_REPEAT_MASK_DEFAULT ((1U << 0) | (1U << 1))  /*!< HOUR and MIN buttons */
 #define SYSTEM_TICK_MS         1     /*!< SysTick period */
 
 /* Interrupt Priorities ------------------------------------------------------*/
 #define EXTI_PRIORITY          0     /*!< Highest priority for button */
 #define SYSTICK_PRIORITY       1     /*!< Medium priority for systick */
+#define BUTTON_TIMER_PRIORITY  EXTI_PRIORITY  /*!< Same as EXTI: never preempt each other */
+#define LED_PATTERN_PRIORITY   3     /*!< One-shot end only - lowest urgency */
+#define I2C_DMA_PRIORITY       2     /*!< End of a bulk I2C write */
 
 #endif
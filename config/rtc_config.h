@@ -29,6 +29,17 @@
 #define RTC_LSE_ASYNC_PRESCALER      127
 #define RTC_LSE_SYNC_PRESCALER       255     /* (127+1)*(255+1) = 32768 */
 
+/* Active prescalers and resulting RTCCLK (LSI value is nominal) */
+#if RTC_SOURCE == RTC_CLOCK_SOURCE_LSI
+    #define RTC_ASYNC_PRESCALER      RTC_LSI_ASYNC_PRESCALER
+    #define RTC_SYNC_PRESCALER       RTC_LSI_SYNC_PRESCALER
+#else
+    #define RTC_ASYNC_PRESCALER      RTC_LSE_ASYNC_PRESCALER
+    #define RTC_SYNC_PRESCALER       RTC_LSE_SYNC_PRESCALER
+#endif
+
+#define RTC_CLOCK_HZ                 ((RTC_ASYNC_PRESCALER + 1U) * (RTC_SYNC_PRESCALER + 1U))
+
 /*===================================================================
   Time Format
   ===================================================================*/
@@ -47,6 +58,15 @@
 /* Only for alarm persistence, not for RTC initialization check */
 #define ALARM_ENABLED_MAGIC      0xCCCC
 
+/* Warm-boot marker: LCD configured and CGRAM loaded by the previous run */
+#define BKP_REG_DISPLAY_MARKER   4   /* RTC_BKP4R: Display ready marker */
+#define DISPLAY_READY_MAGIC      0xD15A
+
+/* Glyph cache slot map (glyph ID per CGRAM slot, 0xFF = empty), so a warm
+   boot knows what CGRAM still holds */
+#define BKP_REG_GLYPH_SLOTS_LO   5   /* RTC_BKP5R: Slots 0-3 */
+#define BKP_REG_GLYPH_SLOTS_HI   6   /* RTC_BKP6R: Slots 4-7 */
+
 /*===================================================================
   Timeout Values (in cycles)
   ===================================================================*/
@@ -65,6 +85,10 @@
 #define RTC_ALARM_A_ENABLE          1
 #define RTC_ALARM_A_TIMEOUT         100000  /* Timeout for alarm write */
 
+/* Alarm B Configuration */
+#define RTC_ALARM_B_ENABLE          1
+#define RTC_ALARM_B_TIMEOUT         100000  /* Timeout for alarm write */
+
 /* Interrupt Configuration */
 #define RTC_ALARM_EXTI_LINE         17      /* EXTI line 17 for RTC Alarm */
 #define RTC_ALARM_IRQn              RTC_Alarm_IRQn
@@ -81,6 +105,10 @@
 #define RTC_ALARM_MASK_HH_MM_SS     0x08    /* Match hour, minute, second */
 #define RTC_ALARM_MASK_ALL          0x0F    /* Match everything */
 
+/* Sub-second match (MASKSS): compare SS[n-1:0], 0 = ignore sub-seconds */
+#define RTC_ALARM_SS_MASK_NONE      0
+#define RTC_ALARM_SS_MASK_ALL       15      /* Compare SS[14:0] */
+
 /*=====================================================================
  Periodic Interrupt
  =====================================================================*/
@@ -94,6 +122,12 @@
 #define RTC_WAKEUP_CLOCK_SOURCE         RTC_WAKEUP_CLOCK_CK_SPRE_17BITS  /* 1Hz clock */
 #define RTC_WAKEUP_EXTI_LINE            22  /* EXTI Line 22 for RTC Wakeup */
 
+/* Sub-second wakeup limits (RTCCLK/2 .. RTCCLK/16 with a 16-bit reload) */
+#define RTC_WAKEUP_MAX_SUBSECOND_MS     ((65536U * 1000U) / (RTC_CLOCK_HZ / 16U))  /* 32 s */
+
+/* Wakeup dispatcher: subscribers sharing the single wakeup timer */
+#define RTC_WAKEUP_MAX_SUBSCRIBERS      8
+
 /* Timeout values */
 #define RTC_WAKEUP_WRITE_TIMEOUT        1000
 
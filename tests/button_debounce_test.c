@@ -0,0 +1,203 @@
+/**
+  ******************************************************************************
+  * @file    button_debounce_test.c
+  * @brief   Host fuzz test and benchmark for the vertical-counter debouncer.
+  * @note    Build and run from the repository root:
+  *            gcc -std=c11 -O2 -Wall -ICore/Inc/drivers \
+  *                tests/button_debounce_test.c Core/Src/drivers/button_debounce.c \
+  *                -o button_debounce_test && ./button_debounce_test
+  *          Exit status is non-zero on any failure.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "button_debounce.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+/* Private define ------------------------------------------------------------*/
+#define LANES               4
+#define FUZZ_SAMPLES        1000000U
+#define WAVEFORM_PRESSES    20000U
+#define BENCH_SAMPLES       50000000U
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t rng_state = 0x12345678U;
+static unsigned failures = 0;
+
+/* Private functions ---------------------------------------------------------*/
+
+/* xorshift32: deterministic, so a failure reproduces */
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+#define CHECK(cond, ...) do {                   \
+    if (!(cond)) {                              \
+        failures++;                             \
+        if (failures <= 10) {                   \
+            printf("FAIL: " __VA_ARGS__);       \
+            printf("\n");                       \
+        }                                       \
+    }                                           \
+} while (0)
+
+/* Per-lane reference: count disagreeing samples, toggle at the limit */
+typedef struct {
+    bool state;
+    uint8_t count;
+} reference_lane_t;
+
+static bool reference_step(reference_lane_t* lane, bool sample) {
+    if (sample == lane->state) {
+        lane->count = 0;
+        return false;
+    }
+    if (++lane->count < BUTTON_DEBOUNCE_SAMPLES) {
+        return false;
+    }
+    lane->state = sample;
+    lane->count = 0;
+    return true;
+}
+
+/**
+  * @brief  Random samples on all lanes: bit-parallel result must match the
+  *         scalar reference lane by lane, sample by sample.
+  */
+static void test_matches_reference(void) {
+    button_debounce_t db;
+    reference_lane_t ref[LANES] = {0};
+
+    button_debounce_init(&db, 0);
+
+    for (uint32_t n = 0; n < FUZZ_SAMPLES; n++) {
+        /* Bias towards runs so lanes actually reach the toggle count */
+        uint8_t sample = (uint8_t)(rng() & ((1U << LANES) - 1U));
+        if (rng() & 1U) {
+            sample = db.state ^ (uint8_t)(rng() & ((1U << LANES) - 1U));
+        }
+
+        uint8_t toggled = button_debounce_step(&db, sample);
+
+        for (uint8_t i = 0; i < LANES; i++) {
+            bool ref_toggled = reference_step(&ref[i], (sample >> i) & 1U);
+
+            CHECK(((toggled >> i) & 1U) == ref_toggled,
+                  "sample %u lane %u: toggle %u, reference %u",
+                  (unsigned)n, (unsigned)i, (unsigned)((toggled >> i) & 1U), (unsigned)ref_toggled);
+            CHECK(((db.state >> i) & 1U) == ref[i].state,
+                  "sample %u lane %u: state differs from reference", (unsigned)n, (unsigned)i);
+        }
+    }
+}
+
+/**
+  * @brief  Bouncy presses and releases: each real transition (bounce runs
+  *         shorter than the toggle count, then a stable level) must give
+  *         exactly one toggle on its lane and none on the others.
+  */
+static void test_bounce_waveforms(void) {
+    button_debounce_t db;
+    uint8_t level = 0;
+
+    button_debounce_init(&db, 0);
+
+    for (uint32_t n = 0; n < WAVEFORM_PRESSES; n++) {
+        uint8_t lane = (uint8_t)(rng() % LANES);
+        uint8_t bit = (uint8_t)(1U << lane);
+        uint8_t target = level ^ bit;
+        uint32_t toggles = 0;
+        uint8_t other_toggles = 0;
+
+        /* Bounce: alternating runs of 1-3 samples at either level */
+        uint8_t bursts = (uint8_t)(rng() % 8U);
+        for (uint8_t b = 0; b < bursts; b++) {
+            uint8_t run = (uint8_t)(1U + rng() % (BUTTON_DEBOUNCE_SAMPLES - 1U));
+            uint8_t sample = (b & 1U) ? level : target;
+
+            for (uint8_t r = 0; r < run; r++) {
+                uint8_t toggled = button_debounce_step(&db, sample);
+                toggles += (toggled & bit) ? 1U : 0U;
+                other_toggles |= toggled & (uint8_t)~bit;
+            }
+        }
+
+        /* Contacts settle */
+        for (uint8_t r = 0; r < BUTTON_DEBOUNCE_SAMPLES + (rng() % 20U); r++) {
+            uint8_t toggled = button_debounce_step(&db, target);
+            toggles += (toggled & bit) ? 1U : 0U;
+            other_toggles |= toggled & (uint8_t)~bit;
+        }
+
+        CHECK(toggles == 1, "transition %u lane %u: %u toggles", (unsigned)n, (unsigned)lane,
+              (unsigned)toggles);
+        CHECK(other_toggles == 0, "transition %u: other lanes toggled (0x%02X)", (unsigned)n,
+              (unsigned)other_toggles);
+        CHECK(db.state == target, "transition %u: state 0x%02X, expected 0x%02X", (unsigned)n,
+              (unsigned)db.state, (unsigned)target);
+
+        level = target;
+    }
+}
+
+/**
+  * @brief  Glitches shorter than the toggle count never reach the state.
+  */
+static void test_glitch_rejected(void) {
+    button_debounce_t db;
+
+    for (uint8_t width = 1; width < BUTTON_DEBOUNCE_SAMPLES; width++) {
+        button_debounce_init(&db, 0);
+        uint8_t toggled = 0;
+
+        for (uint8_t r = 0; r < width; r++) {
+            toggled |= button_debounce_step(&db, 0x0F);
+        }
+        toggled |= button_debounce_step(&db, 0x00);
+
+        CHECK(toggled == 0 && db.state == 0, "glitch of %u samples got through", (unsigned)width);
+    }
+}
+
+/**
+  * @brief  Cost per sample (all lanes at once).
+  */
+static void bench_step(void) {
+    button_debounce_t db;
+    volatile uint8_t sink = 0;
+    uint8_t sample = 0;
+
+    button_debounce_init(&db, 0);
+
+    clock_t start = clock();
+    for (uint32_t n = 0; n < BENCH_SAMPLES; n++) {
+        /* Cheap varying input: lanes flip at different rates */
+        sample = (uint8_t)((n >> 3) ^ (n >> 5)) & 0x0FU;
+        sink ^= button_debounce_step(&db, sample);
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("bench: %u samples x %u lanes in %.3f s (%.2f ns/sample)\n",
+           (unsigned)BENCH_SAMPLES, (unsigned)LANES, seconds,
+           seconds * 1e9 / (double)BENCH_SAMPLES);
+    (void)sink;
+}
+
+int main(void) {
+    test_matches_reference();
+    test_bounce_waveforms();
+    test_glitch_rejected();
+    bench_step();
+
+    if (failures != 0) {
+        printf("%u failure(s)\n", failures);
+        return 1;
+    }
+    printf("button_debounce: all tests passed\n");
+    return 0;
+}
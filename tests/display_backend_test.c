@@ -0,0 +1,322 @@
+/**
+  ******************************************************************************
+  * @file    display_backend_test.c
+  * @brief   Host test for the emulated display backends.
+  * @note    Build and run both backends from the repository root:
+  *            gcc -std=gnu11 -O2 -Wall -DDISPLAY_TYPE=3 \
+  *                -Itests/stubs -ICore/Inc/drivers -Iconfig \
+  *                tests/display_backend_test.c Core/Src/drivers/display_backend.c \
+  *                Core/Src/drivers/custom_chars.c \
+  *                -o display_backend_test_terminal && ./display_backend_test_terminal
+  *            gcc -std=gnu11 -O2 -Wall -DDISPLAY_TYPE=2 \
+  *                -Itests/stubs -ICore/Inc/drivers -Iconfig \
+  *                tests/display_backend_test.c Core/Src/drivers/display_backend.c \
+  *                Core/Src/drivers/ssd1306.c Core/Src/drivers/custom_chars.c \
+  *                -o display_backend_test_ssd1306 && ./display_backend_test_ssd1306
+  *          Terminal: the printed window is captured and compared cell by
+  *          cell, and bytes are counted as the PCF8574 would send them.
+  *          SSD1306: a stub I2C counts the bytes of every dirty span, and
+  *          the framebuffer after a page flip or banner shift must match
+  *          the same window drawn from scratch. Exit status is non-zero on
+  *          any failure.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "display_backend.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#if DISPLAY_TYPE == DISPLAY_HOST_TERMINAL
+#include <unistd.h>
+#elif DISPLAY_TYPE == DISPLAY_OLED_SSD1306
+#include "i2c.h"
+#include "ssd1306.h"
+#else
+#error "display_backend_test: build with -DDISPLAY_TYPE=2 (SSD1306) or 3 (terminal)"
+#endif
+
+/* Private define ------------------------------------------------------------*/
+#define COLS                DISPLAY_BACKEND_VISIBLE_COLS
+#define PAGE_TWO            16      /* First column of the second page */
+
+/* Private variables ---------------------------------------------------------*/
+static unsigned failures = 0;
+
+/* Private functions ---------------------------------------------------------*/
+
+#define CHECK(cond, ...) do {                   \
+    if (!(cond)) {                              \
+        failures++;                             \
+        if (failures <= 10) {                   \
+            printf("FAIL: " __VA_ARGS__);       \
+            printf("\n");                       \
+        }                                       \
+    }                                           \
+} while (0)
+
+/* Text at consecutive cells, one cursor set (as the renderer sends it) */
+static void write_text(uint8_t row, uint8_t col, const char* str) {
+    display_backend_set_cursor(row, col);
+    while (*str != '\0') {
+        display_backend_write_char(row, col, *str++);
+        col = (uint8_t)((col + 1) % DISPLAY_BACKEND_COLS);
+    }
+}
+
+#if DISPLAY_TYPE == DISPLAY_HOST_TERMINAL
+
+/* ----- Terminal: capture what the backend prints ----- */
+
+static char output[1024];
+
+/* Run one poll with stdout redirected; returns the bytes printed */
+static size_t capture_poll(void) {
+    FILE* tmp = tmpfile();
+    int saved = dup(STDOUT_FILENO);
+    size_t len = 0;
+
+    fflush(stdout);
+    dup2(fileno(tmp), STDOUT_FILENO);
+    display_backend_poll();
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+
+    rewind(tmp);
+    len = fread(output, 1, sizeof(output) - 1, tmp);
+    output[len] = '\0';
+    fclose(tmp);
+    return len;
+}
+
+/* Printed window row: "+----+\n|row 0|\n|row 1|\n+----+\n" after the home code */
+static bool window_row_is(uint8_t row, const char* expected) {
+    const char* line = strchr(output, '\n');
+
+    if (line == NULL || strlen(line) < 2U + (COLS + 3U) * 2U) {
+        return false;
+    }
+    line += 2 + row * (COLS + 3);
+    return strncmp(line, expected, COLS) == 0;
+}
+
+static void bring_up(void) {
+    display_backend_init_start(false);
+    FILE* saved = stdout;
+    stdout = fopen("/dev/null", "w");   /* Screen clear code */
+    display_backend_init_poll();
+    fclose(stdout);
+    stdout = saved;
+    capture_poll();
+}
+
+/**
+  * @brief  Bus bytes as the PCF8574 would send them: 4 per HD44780 byte.
+  */
+static void test_terminal_bytes(void) {
+    uint32_t start = display_backend_byte_count();
+
+    write_text(0, 0, "12:34:56");
+    CHECK(display_backend_byte_count() - start == (1 + 8) * 4,
+          "cursor + 8 characters cost %u bytes", (unsigned)(display_backend_byte_count() - start));
+
+    start = display_backend_byte_count();
+    display_backend_put_glyph(0, 15, GLYPH_BELL);
+    CHECK(display_backend_byte_count() - start == 2 * 4,
+          "glyph cell cost %u bytes", (unsigned)(display_backend_byte_count() - start));
+
+    /* Page flip: 16 shifts left; back to 0 is one return-home */
+    start = display_backend_byte_count();
+    display_backend_set_offset(PAGE_TWO);
+    CHECK(display_backend_byte_count() - start == PAGE_TWO * 4,
+          "flip to page two cost %u bytes", (unsigned)(display_backend_byte_count() - start));
+
+    start = display_backend_byte_count();
+    display_backend_set_offset(0);
+    CHECK(display_backend_byte_count() - start == 4,
+          "return home cost %u bytes", (unsigned)(display_backend_byte_count() - start));
+
+    /* Banner step past column 39: one shift the short way round */
+    start = display_backend_byte_count();
+    display_backend_set_offset(DISPLAY_BACKEND_COLS - 1);
+    CHECK(display_backend_byte_count() - start == 4,
+          "one-step wrap cost %u bytes", (unsigned)(display_backend_byte_count() - start));
+    display_backend_set_offset(0);
+}
+
+/**
+  * @brief  The printed window follows writes, flips and banner shifts,
+  *         and nothing is printed when nothing changed.
+  */
+static void test_terminal_window(void) {
+    display_backend_clear();
+    capture_poll();
+
+    write_text(0, 0, "12:34:56");
+    write_text(1, 0, "18/10/2026");
+    display_backend_put_glyph(0, 15, GLYPH_BELL);
+    write_text(0, PAGE_TWO, "PAGE TWO");
+
+    CHECK(capture_poll() > 0, "changed window not printed");
+    CHECK(window_row_is(0, "12:34:56       ^"), "row 0 after writes: %s", output);
+    CHECK(window_row_is(1, "18/10/2026      "), "row 1 after writes: %s", output);
+
+    CHECK(capture_poll() == 0, "unchanged window printed again");
+
+    /* Writes off the window are kept, not printed */
+    write_text(1, PAGE_TWO, "OFF SCREEN");
+    CHECK(capture_poll() == 0, "write outside the window printed");
+
+    display_backend_set_offset(PAGE_TWO);
+    CHECK(capture_poll() > 0, "flip not printed");
+    CHECK(window_row_is(0, "PAGE TWO        "), "row 0 after flip: %s", output);
+    CHECK(window_row_is(1, "OFF SCREEN      "), "row 1 after flip: %s", output);
+
+    /* Banner shift across the wrap: window starts at column 39 */
+    write_text(0, DISPLAY_BACKEND_COLS - 1, "X");
+    display_backend_set_offset(DISPLAY_BACKEND_COLS - 1);
+    capture_poll();
+    CHECK(window_row_is(0, "X12:34:56       "), "row 0 at offset 39: %s", output);
+
+    display_backend_set_offset(0);
+    capture_poll();
+    CHECK(window_row_is(0, "12:34:56       ^"), "row 0 back at offset 0: %s", output);
+}
+
+#else /* DISPLAY_OLED_SSD1306 */
+
+/* ----- SSD1306: stub I2C, dirty spans straight to the "bus" ----- */
+
+static uint32_t bus_bytes;
+
+i2c_status_t i2c_write_dma(uint8_t dev_addr, const uint8_t* data, uint16_t len) {
+    (void)dev_addr;
+    (void)data;
+    bus_bytes += len;
+    return I2C_OK;
+}
+
+bool i2c_dma_busy(void) {
+    return false;
+}
+
+i2c_status_t i2c_get_last_error(void) {
+    return I2C_OK;
+}
+
+static uint8_t snapshot[SSD1306_PAGES * SSD1306_WIDTH];
+
+/* Send everything dirty; returns the flush bytes of this frame */
+static uint32_t flush_frame(void) {
+    uint32_t start = display_backend_byte_count();
+
+    while (display_backend_poll()) {
+    }
+    return display_backend_byte_count() - start;
+}
+
+static void bring_up(void) {
+    display_backend_init_start(false);
+    display_backend_init_poll();
+
+    /* Power-up: GDDRAM is random, every page goes out once */
+    uint32_t bytes = flush_frame();
+    CHECK(bytes == SSD1306_PAGES * (7U + 1U + SSD1306_WIDTH),
+          "first frame sent %u bytes", (unsigned)bytes);
+}
+
+/**
+  * @brief  Bytes per frame: one window command plus the changed span.
+  */
+static void test_ssd1306_bytes(void) {
+    display_backend_clear();
+    flush_frame();
+
+    /* 'A' has 5 lit columns, the spacing column stays dark */
+    write_text(0, 0, "A");
+    uint32_t bytes = flush_frame();
+    CHECK(bytes == 7U + 1U + SSD1306_FONT_W, "one character sent %u bytes", (unsigned)bytes);
+
+    write_text(0, 0, "A");
+    CHECK(!display_backend_pending(), "rewriting the same character marked a span");
+    CHECK(flush_frame() == 0, "unchanged frame sent bytes");
+
+    /* Seconds tick: only inside the last digit's cell */
+    write_text(0, 0, "12:34:56");
+    flush_frame();
+    write_text(0, 0, "12:34:57");
+    bytes = flush_frame();
+    CHECK(bytes > 0 && bytes <= 7U + 1U + SSD1306_FONT_W,
+          "seconds tick sent %u bytes", (unsigned)bytes);
+
+    /* Two pages with the same content: a flip changes no pixel */
+    write_text(0, PAGE_TWO, "12:34:57");
+    flush_frame();
+    display_backend_set_offset(PAGE_TWO);
+    CHECK(flush_frame() == 0, "flip between identical pages sent bytes");
+    display_backend_set_offset(0);
+}
+
+/**
+  * @brief  The framebuffer after a flip or banner shift equals the same
+  *         window drawn from scratch at offset 0.
+  */
+static void test_ssd1306_window(void) {
+    /* Flip to page two */
+    display_backend_clear();
+    write_text(0, 0, "12:34:56");
+    write_text(1, 0, "18/10/2026");
+    write_text(0, PAGE_TWO, "SUNDAY");
+    display_backend_put_glyph(1, PAGE_TWO + 15, GLYPH_ALARM_ON);
+    flush_frame();
+    display_backend_set_offset(PAGE_TWO);
+    uint32_t bytes = flush_frame();
+    memcpy(snapshot, ssd1306_get_framebuffer(), sizeof(snapshot));
+
+    display_backend_clear();
+    write_text(0, 0, "SUNDAY");
+    display_backend_put_glyph(1, 15, GLYPH_ALARM_ON);
+    flush_frame();
+    CHECK(memcmp(snapshot, ssd1306_get_framebuffer(), sizeof(snapshot)) == 0,
+          "page two after a flip differs from page two drawn directly");
+    CHECK(bytes > 0 && bytes < SSD1306_PAGES * (7U + 1U + SSD1306_WIDTH),
+          "flip sent %u bytes", (unsigned)bytes);
+
+    /* Banner shift across the wrap: window starts at column 39 */
+    display_backend_clear();
+    write_text(0, DISPLAY_BACKEND_COLS - 1, "ALARM 07:30");
+    flush_frame();
+    display_backend_set_offset(DISPLAY_BACKEND_COLS - 1);
+    flush_frame();
+    memcpy(snapshot, ssd1306_get_framebuffer(), sizeof(snapshot));
+
+    display_backend_clear();
+    write_text(0, 0, "ALARM 07:30");
+    flush_frame();
+    CHECK(memcmp(snapshot, ssd1306_get_framebuffer(), sizeof(snapshot)) == 0,
+          "window at offset 39 differs from the same text drawn at 0");
+}
+
+#endif
+
+int main(void) {
+    bring_up();
+
+#if DISPLAY_TYPE == DISPLAY_HOST_TERMINAL
+    test_terminal_bytes();
+    test_terminal_window();
+#else
+    test_ssd1306_bytes();
+    test_ssd1306_window();
+#endif
+
+    if (failures != 0) {
+        printf("%u failure(s)\n", failures);
+        return 1;
+    }
+    printf("display_backend (%s): all tests passed\n",
+           (DISPLAY_TYPE == DISPLAY_HOST_TERMINAL) ? "terminal" : "ssd1306");
+    return 0;
+}
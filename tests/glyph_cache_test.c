@@ -0,0 +1,319 @@
+/**
+  ******************************************************************************
+  * @file    glyph_cache_test.c
+  * @brief   Host test for the CGRAM glyph cache against a stub LCD.
+  * @note    Build and run from the repository root:
+  *            gcc -std=c11 -O2 -Wall -Itests/stubs -ICore/Inc/drivers -Iconfig \
+  *                tests/glyph_cache_test.c Core/Src/drivers/glyph_cache.c \
+  *                Core/Src/drivers/custom_chars.c \
+  *                -o glyph_cache_test && ./glyph_cache_test
+  *          The stub LCD keeps its own CGRAM and DDRAM, so every check is
+  *          against what the panel would show, and counts the CGRAM upload
+  *          bytes of each layout sequence. Exit status is non-zero on any
+  *          failure.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "glyph_cache.h"
+#include "lcd1602_i2c.h"
+#include "rtc_config.h"
+#include "stm32f4xx.h"
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define LCD_ROWS            2
+#define LCD_COLS            40
+#define CELL_TEXT           0xFF    /* DDRAM cell holds a ROM character */
+#define MAX_CELLS           32
+#define RESET_TRIALS        200U
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* A layout as the glyph cache sees it: the glyph cells of one frame */
+typedef struct {
+    const char* name;
+    uint8_t count;
+    struct { uint8_t row, col; glyph_id_t glyph; } cells[MAX_CELLS];
+} glyph_layout_t;
+
+/* Private variables ---------------------------------------------------------*/
+RTC_TypeDef test_rtc;
+
+static uint8_t cgram[GLYPH_CACHE_SLOTS][8];
+static uint8_t ddram[LCD_ROWS][LCD_COLS];
+static uint8_t cursor_row, cursor_col;
+static uint32_t upload_bytes;
+static uint32_t uploads_left;       /* Simulated reset when it reaches 0 */
+static jmp_buf reset_jmp;
+static unsigned failures = 0;
+
+/* Private functions ---------------------------------------------------------*/
+
+#define CHECK(cond, ...) do {                   \
+    if (!(cond)) {                              \
+        failures++;                             \
+        if (failures <= 10) {                   \
+            printf("FAIL: " __VA_ARGS__);       \
+            printf("\n");                       \
+        }                                       \
+    }                                           \
+} while (0)
+
+/* Glyph the persisted slot map claims for a slot */
+static uint8_t bkp_slot_glyph(uint8_t slot) {
+    uint32_t word = (slot < 4) ? test_rtc.BKP5R : test_rtc.BKP6R;
+    return (uint8_t)(word >> ((slot & 3U) * 8));
+}
+
+/* ----- Stub LCD driver ----- */
+
+void lcd_set_cursor(uint8_t row, uint8_t col) {
+    cursor_row = row;
+    cursor_col = col;
+}
+
+void lcd_write_custom_char(uint8_t location) {
+    if (cursor_row < LCD_ROWS && cursor_col < LCD_COLS) {
+        ddram[cursor_row][cursor_col] = location;
+    }
+    cursor_col++;
+}
+
+void lcd_create_char(uint8_t location, const uint8_t charmap[8]) {
+    /* A reset from here until the glyph is in must not find the slot
+       persisted as holding anything */
+    CHECK(bkp_slot_glyph(location) == GLYPH_NONE,
+          "slot %u persisted as glyph %u during its upload",
+          (unsigned)location, (unsigned)bkp_slot_glyph(location));
+
+    if (uploads_left != 0 && --uploads_left == 0) {
+        /* Reset mid-upload: CGRAM row content is undefined, and nothing
+           after this point runs */
+        memset(cgram[location], 0xAA, sizeof(cgram[location]));
+        longjmp(reset_jmp, 1);
+    }
+
+    memcpy(cgram[location], charmap, sizeof(cgram[location]));
+    upload_bytes += GLYPH_UPLOAD_BYTES;
+}
+
+/* ----- Layouts (glyph cells as display_manager draws them) ----- */
+
+/* "12:08" in big digits: the 7 segment glyphs */
+static const glyph_layout_t layout_big_time = { "big time", 20, {
+    { 0, 0,  GLYPH_BIG_UB  }, { 0, 1,  GLYPH_BIG_RT  },
+    { 1, 0,  GLYPH_BIG_LB  }, { 1, 2,  GLYPH_BIG_LB  },
+    { 0, 4,  GLYPH_BIG_UMB }, { 0, 5,  GLYPH_BIG_UMB }, { 0, 6,  GLYPH_BIG_RT  },
+    { 1, 4,  GLYPH_BIG_LL  }, { 1, 5,  GLYPH_BIG_LB  }, { 1, 6,  GLYPH_BIG_LB  },
+    { 0, 9,  GLYPH_BIG_LT  }, { 0, 10, GLYPH_BIG_UB  }, { 0, 11, GLYPH_BIG_RT  },
+    { 1, 9,  GLYPH_BIG_LL  }, { 1, 10, GLYPH_BIG_LB  }, { 1, 11, GLYPH_BIG_LR  },
+    { 0, 13, GLYPH_BIG_LT  }, { 0, 14, GLYPH_BIG_UMB }, { 0, 15, GLYPH_BIG_RT  },
+    { 1, 13, GLYPH_BIG_LL  },
+} };
+
+/* Alarm icon in the corner of the full layout */
+static const glyph_layout_t layout_full = { "full", 1, {
+    { 0, 15, GLYPH_ALARM_ON },
+} };
+
+/* Alarm focus with the alarm armed */
+static const glyph_layout_t layout_alarm_focus = { "alarm focus", 1, {
+    { 0, 15, GLYPH_BELL },
+} };
+
+/* Every icon at once: more distinct glyphs than slots */
+static const glyph_layout_t layout_icons = { "icons", 9, {
+    { 0, 0, GLYPH_BELL     }, { 0, 1, GLYPH_ALARM_ON }, { 0, 2, GLYPH_ALARM_OFF },
+    { 0, 3, GLYPH_CHECK    }, { 0, 4, GLYPH_CROSS    }, { 0, 5, GLYPH_CLOCK     },
+    { 0, 6, GLYPH_CALENDAR }, { 0, 7, GLYPH_SETTINGS }, { 0, 8, GLYPH_BIG_LT    },
+} };
+
+static void screen_clear(void) {
+    memset(ddram, CELL_TEXT, sizeof(ddram));
+    glyph_cache_screen_cleared();
+}
+
+/* Draw a layout after a clear, as a layout switch does; bytes uploaded */
+static uint32_t draw_layout(const glyph_layout_t* layout) {
+    uint32_t before = upload_bytes;
+
+    screen_clear();
+    for (uint8_t i = 0; i < layout->count; i++) {
+        glyph_cache_put(layout->cells[i].row, layout->cells[i].col, layout->cells[i].glyph);
+    }
+    glyph_cache_redraw_stale(0, GLYPH_CACHE_COLS);
+
+    return upload_bytes - before;
+}
+
+/* Every cell of the layout shows its glyph's bitmap on the panel */
+static bool layout_on_screen(const glyph_layout_t* layout) {
+    for (uint8_t i = 0; i < layout->count; i++) {
+        uint8_t slot = ddram[layout->cells[i].row][layout->cells[i].col];
+
+        if (slot >= GLYPH_CACHE_SLOTS ||
+            memcmp(cgram[slot], glyph_bitmaps[layout->cells[i].glyph], 8) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void cold_start(void) {
+    memset(&test_rtc, 0, sizeof(test_rtc));
+    memset(cgram, 0, sizeof(cgram));
+    upload_bytes = 0;
+    uploads_left = 0;
+    glyph_cache_init();
+    glyph_cache_reset_stats();
+}
+
+/**
+  * @brief  CGRAM bytes per layout sequence: a cold draw uploads each glyph
+  *         once, a redraw nothing, a round trip only what was evicted.
+  */
+static void test_layout_sequences(void) {
+    static const struct {
+        const glyph_layout_t* layout;
+        uint32_t bytes;
+    } steps[] = {
+        { &layout_big_time,    7 * GLYPH_UPLOAD_BYTES },  /* Cold: 7 segments */
+        { &layout_big_time,    0 },                       /* Same frame again */
+        { &layout_full,        1 * GLYPH_UPLOAD_BYTES },  /* Last free slot */
+        { &layout_alarm_focus, 1 * GLYPH_UPLOAD_BYTES },  /* Evicts one segment */
+        /* LRU does not know the frame ahead: reloading the evicted segment
+           evicts one not redrawn yet, and so on until the icons go */
+        { &layout_big_time,    3 * GLYPH_UPLOAD_BYTES },
+        { &layout_big_time,    0 },
+        { &layout_full,        1 * GLYPH_UPLOAD_BYTES },
+        { &layout_alarm_focus, 1 * GLYPH_UPLOAD_BYTES },
+        { &layout_big_time,    3 * GLYPH_UPLOAD_BYTES },
+    };
+    uint32_t total = 0;
+
+    cold_start();
+
+    printf("%-12s %6s\n", "layout", "bytes");
+    for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        uint32_t bytes = draw_layout(steps[i].layout);
+
+        printf("%-12s %6u\n", steps[i].layout->name, (unsigned)bytes);
+        CHECK(bytes == steps[i].bytes, "step %u (%s): %u upload bytes, expected %u",
+              (unsigned)i, steps[i].layout->name, (unsigned)bytes, (unsigned)steps[i].bytes);
+        CHECK(layout_on_screen(steps[i].layout), "step %u (%s): wrong glyph on screen",
+              (unsigned)i, steps[i].layout->name);
+        total += bytes;
+    }
+
+    glyph_cache_stats_t stats;
+    glyph_cache_get_stats(&stats);
+    printf("%-12s %6u (%u uploads)\n", "total", (unsigned)total,
+           (unsigned)(total / GLYPH_UPLOAD_BYTES));
+    CHECK(stats.upload_bytes == total, "stats count %u upload bytes, LCD saw %u",
+          (unsigned)stats.upload_bytes, (unsigned)total);
+}
+
+/**
+  * @brief  More distinct glyphs than slots: evicted cells are redrawn, and
+  *         the frame still settles on what fits.
+  */
+static void test_overcommit(void) {
+    cold_start();
+    draw_layout(&layout_icons);
+
+    glyph_cache_stats_t stats;
+    glyph_cache_get_stats(&stats);
+    CHECK(stats.evictions >= 1, "9 glyphs in 8 slots without an eviction");
+
+    /* The one-pass redraw leaves exactly one cell showing a stale slot */
+    uint8_t wrong = 0;
+    for (uint8_t i = 0; i < layout_icons.count; i++) {
+        uint8_t slot = ddram[0][layout_icons.cells[i].col];
+        if (slot >= GLYPH_CACHE_SLOTS ||
+            memcmp(cgram[slot], glyph_bitmaps[layout_icons.cells[i].glyph], 8) != 0) {
+            wrong++;
+        }
+    }
+    CHECK(wrong <= 1, "%u icon cells wrong after an overcommitted frame", (unsigned)wrong);
+}
+
+/**
+  * @brief  Warm boot: a restored map redraws the last layout for free.
+  */
+static void test_warm_restore(void) {
+    cold_start();
+    draw_layout(&layout_big_time);
+    draw_layout(&layout_full);
+
+    glyph_cache_restore();
+    uint32_t bytes = draw_layout(&layout_big_time) + draw_layout(&layout_full);
+
+    CHECK(bytes == 0, "warm boot uploaded %u bytes for resident glyphs", (unsigned)bytes);
+    CHECK(layout_on_screen(&layout_full), "warm boot: wrong icon on screen");
+}
+
+/**
+  * @brief  Draw a layout sequence with a reset at the given upload, then
+  *         warm boot and redraw the layout the reset interrupted.
+  * @retval false if the sequence finished before that upload
+  */
+static bool reset_trial(uint32_t trial) {
+    static const glyph_layout_t* const sequence[] = {
+        &layout_big_time, &layout_full, &layout_alarm_focus, &layout_icons,
+        &layout_big_time, &layout_alarm_focus, &layout_big_time,
+    };
+    volatile size_t i = 0;
+
+    cold_start();
+    uploads_left = trial;
+
+    if (setjmp(reset_jmp) == 0) {
+        for (; i < sizeof(sequence) / sizeof(sequence[0]); i++) {
+            draw_layout(sequence[i]);
+        }
+        return false;
+    }
+    uploads_left = 0;
+
+    glyph_cache_restore();
+    const glyph_layout_t* layout = sequence[i];
+    if (layout == &layout_icons) {
+        layout = &layout_big_time;      /* Overcommitted: never exact */
+    }
+    draw_layout(layout);
+
+    CHECK(layout_on_screen(layout), "reset at upload %u: %s shows a torn glyph",
+          (unsigned)trial, layout->name);
+    return true;
+}
+
+/**
+  * @brief  Reset during an upload: after the warm boot every glyph drawn
+  *         must be the right bitmap, whichever upload the reset hit.
+  */
+static void test_reset_during_upload(void) {
+    uint32_t trial = 1;
+
+    while (trial <= RESET_TRIALS && reset_trial(trial)) {
+        trial++;
+    }
+    CHECK(trial > 20, "sequence ran only %u uploads", (unsigned)(trial - 1));
+}
+
+int main(void) {
+    test_layout_sequences();
+    test_overcommit();
+    test_warm_restore();
+    test_reset_during_upload();
+
+    if (failures != 0) {
+        printf("%u failure(s)\n", failures);
+        return 1;
+    }
+    printf("glyph_cache: all tests passed\n");
+    return 0;
+}
@@ -0,0 +1,41 @@
+/**
+  ******************************************************************************
+  * @file    stm32f4xx.h
+  * @brief   Host stand-in for the CMSIS device header (tests only).
+  * @note    Provides just the registers the modules under test touch.
+  ******************************************************************************
+  */
+
+#ifndef STM32F4XX_H
+#define STM32F4XX_H
+
+#include <stdint.h>
+
+/* RTC: backup registers only */
+typedef struct {
+    volatile uint32_t BKP0R;
+    volatile uint32_t BKP1R;
+    volatile uint32_t BKP2R;
+    volatile uint32_t BKP3R;
+    volatile uint32_t BKP4R;
+    volatile uint32_t BKP5R;
+    volatile uint32_t BKP6R;
+    volatile uint32_t BKP7R;
+    volatile uint32_t BKP8R;
+    volatile uint32_t BKP9R;
+    volatile uint32_t BKP10R;
+    volatile uint32_t BKP11R;
+    volatile uint32_t BKP12R;
+    volatile uint32_t BKP13R;
+    volatile uint32_t BKP14R;
+    volatile uint32_t BKP15R;
+    volatile uint32_t BKP16R;
+    volatile uint32_t BKP17R;
+    volatile uint32_t BKP18R;
+    volatile uint32_t BKP19R;
+} RTC_TypeDef;
+
+extern RTC_TypeDef test_rtc;
+#define RTC (&test_rtc)
+
+#endif /* STM32F4XX_H */